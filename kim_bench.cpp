@@ -0,0 +1,300 @@
+/*
+ * @brief kim::sec Microbenchmarks
+ * @author Edward Kim
+ *
+ * Usage: bench.out [--min-size BYTES] [--max-size BYTES] [--min-time SECONDS] [--filter SUBSTRING]
+ *
+ * Prints one JSON document to stdout with throughput (MB/s), ns/byte and heap allocations per call
+ * for every primitive at every input size from --min-size to --max-size, multiplying by 4 each step
+ * (16 B up to 1 GiB with --max-size 1073741824).
+ */
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include <random>
+#include <functional>
+#include <filesystem>
+#include <new>
+
+#include <cstdlib>
+#include <cstdint>
+#include <cstddef>
+
+#include "kim_sec.hpp"
+
+/* Heap allocation counter, bumped by the replaced global operator new */
+static std::atomic<std::size_t> g_alloc_count{};
+
+void* operator new(std::size_t p_size)
+{
+    g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+
+    if (void* ptr{std::malloc(p_size ? p_size : 1)}) {
+        return ptr;
+    }
+
+    throw std::bad_alloc{};
+}
+
+void* operator new[](std::size_t p_size)
+{
+    return operator new(p_size);
+}
+
+void* operator new(std::size_t p_size, std::align_val_t p_align)
+{
+    g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+
+    const std::size_t align{static_cast<std::size_t>(p_align)};
+
+    if (void* ptr{std::aligned_alloc(align, (p_size + align - 1) / align * align)}) {
+        return ptr;
+    }
+
+    throw std::bad_alloc{};
+}
+
+void* operator new[](std::size_t p_size, std::align_val_t p_align)
+{
+    return operator new(p_size, p_align);
+}
+
+void operator delete(void* p_ptr, std::align_val_t) noexcept
+{
+    std::free(p_ptr);
+}
+
+void operator delete[](void* p_ptr, std::align_val_t) noexcept
+{
+    std::free(p_ptr);
+}
+
+void operator delete(void* p_ptr, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p_ptr);
+}
+
+void operator delete[](void* p_ptr, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p_ptr);
+}
+
+void operator delete(void* p_ptr) noexcept
+{
+    std::free(p_ptr);
+}
+
+void operator delete[](void* p_ptr) noexcept
+{
+    std::free(p_ptr);
+}
+
+void operator delete(void* p_ptr, std::size_t) noexcept
+{
+    std::free(p_ptr);
+}
+
+void operator delete[](void* p_ptr, std::size_t) noexcept
+{
+    std::free(p_ptr);
+}
+
+namespace
+{
+    /* Keeps results observable so the optimiser cannot drop the benchmarked call */
+    volatile std::size_t g_sink{};
+
+    struct bench_options
+    {
+        std::size_t     min_size{16};
+        std::size_t     max_size{1 << 20};
+        double          min_time{0.2};
+        std::string     filter{};
+    };
+
+    struct bench_result
+    {
+        std::string     name;
+        std::size_t     size;
+        std::size_t     iterations;
+        double          ns_per_op;
+        double          allocs_per_op;
+    };
+
+    /* Repeats p_op until at least p_min_time seconds have passed (always at least once) */
+    bench_result run(const std::string& p_name, const std::size_t p_size, const double p_min_time, const std::function<void()>& p_op)
+    {
+        using clock = std::chrono::steady_clock;
+
+        std::size_t             iterations{};
+        const std::size_t       allocs_before{g_alloc_count.load(std::memory_order_relaxed)};
+        const clock::time_point start{clock::now()};
+        clock::duration         elapsed{};
+
+        do {
+            p_op();
+            iterations++;
+            elapsed = clock::now() - start;
+        } while (std::chrono::duration<double>(elapsed).count() < p_min_time);
+
+        const std::size_t allocs{g_alloc_count.load(std::memory_order_relaxed) - allocs_before};
+
+        return bench_result{p_name, p_size, iterations,
+                            std::chrono::duration<double, std::nano>(elapsed).count() / iterations,
+                            static_cast<double>(allocs) / iterations};
+    }
+
+    /* Random bytes */
+    kim::sec::Binary random_Bin(const std::size_t p_size, std::mt19937_64& p_rng)
+    {
+        kim::sec::Binary ret{};
+        ret.reserve(p_size);
+
+        for (std::size_t index{}; index < p_size; index++) {
+            ret.push_back(static_cast<std::byte>(p_rng()));
+        }
+
+        return ret;
+    }
+
+    /* English-like text so that the XOR crackers see realistic candidate plaintexts */
+    std::string text(const std::size_t p_size)
+    {
+        const std::string   corpus{"Now that the party is jumping with the bass kicked in and the Vega's are pumpin' "
+                                   "Quick to the point, to the point, no faking. Cooking MC's like a pound of bacon. "};
+        std::string         ret{};
+
+        ret.reserve(p_size);
+
+        while (ret.length() < p_size) {
+            ret += corpus.substr(0, p_size - ret.length());
+        }
+
+        return ret;
+    }
+
+    void print_json(const std::vector<bench_result>& p_results)
+    {
+        std::cout << "{\n  \"benchmarks\": [";
+
+        for (std::size_t index{}; index < p_results.size(); index++) {
+            const bench_result& e{p_results[index]};
+
+            std::cout << (index ? ",\n" : "\n")
+                      << "    { \"name\": \"" << e.name << "\""
+                      << ", \"size\": " << e.size
+                      << ", \"iterations\": " << e.iterations
+                      << ", \"ns_per_op\": " << e.ns_per_op
+                      << ", \"ns_per_byte\": " << e.ns_per_op / e.size
+                      << ", \"mb_per_s\": " << (e.size / 1e6) / (e.ns_per_op / 1e9)
+                      << ", \"allocs_per_op\": " << e.allocs_per_op << " }";
+        }
+
+        std::cout << "\n  ]\n}" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    bench_options opts{};
+
+    for (int index{1}; index < argc; index++) {
+        const std::string arg{argv[index]};
+
+        if (index + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return 1;
+        } else if (arg == "--min-size") {
+            opts.min_size = std::stoull(argv[++index]);
+        } else if (arg == "--max-size") {
+            opts.max_size = std::stoull(argv[++index]);
+        } else if (arg == "--min-time") {
+            opts.min_time = std::stod(argv[++index]);
+        } else if (arg == "--filter") {
+            opts.filter = argv[++index];
+        } else {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    std::mt19937_64                 rng{0x6B696D};
+    std::vector<bench_result>       results{};
+    const kim::sec::Binary          aes_key{kim::sec::Hex{"000102030405060708090A0B0C0D0E0F"}};
+    const kim::sec::AesContext      aes_context{aes_key.view()};
+    const kim::sec::Binary          rep_key{"ICE"};
+    const std::filesystem::path     tmp_dir{std::filesystem::temp_directory_path()};
+    const std::string               rep_in_name{(tmp_dir / "kim_bench_rep_in.txt").string()};
+    const std::string               rep_out_name{(tmp_dir / "kim_bench_rep_out.txt").string()};
+    const std::string               ecb_in_name{(tmp_dir / "kim_bench_ecb_in.txt").string()};
+
+    for (std::size_t size{opts.min_size}; size <= opts.max_size; size *= 4) {
+        const kim::sec::Binary      lhs{random_Bin(size, rng)};
+        const kim::sec::Binary      rhs{random_Bin(size, rng)};
+        const kim::sec::Binary      aes_pt{random_Bin(size / 16 * 16, rng)};
+        const kim::sec::Binary      aes_ct{kim::sec::aes_ecb_enc(aes_pt.view(), aes_key.view())};
+        const kim::sec::Hex         lhs_Hex{lhs};
+        const kim::sec::Base64      lhs_B64{lhs};
+        const std::string           lhs_Hex_str{[&] { std::ostringstream os{}; os << lhs_Hex; return os.str(); }()};
+        const std::string           lhs_B64_str{[&] { std::ostringstream os{}; os << lhs_B64; return os.str(); }()};
+        const kim::sec::Binary      byte_ct{kim::sec::XOR(kim::sec::Binary{text(size)}.view(), kim::sec::Binary{std::byte{0x58}}.view())};
+        const kim::sec::BatchView   byte_ct_batch{byte_ct.subview(0, size / 32 * 32), 32};
+        const kim::sec::BatchView   lhs_batch{lhs.subview(0, size / 32 * 32), 32};
+        const kim::sec::BatchView   rhs_batch{rhs.subview(0, size / 32 * 32), 32};
+        const kim::sec::Binary      aes_keys{random_Bin(size / 16 * 16, rng)};
+
+        {
+            std::ofstream rep_in{rep_in_name};
+            rep_in << kim::sec::XOR_rep_key_enc<kim::sec::Hex>(text(size), rep_key);
+        }
+
+        {
+            /* 160 byte ciphertexts, one per line, as in Cryptopals 1.8 */
+            std::ofstream ecb_in{ecb_in_name};
+
+            for (std::size_t index{}; index < lhs.length(); index += 160) {
+                ecb_in << kim::sec::Binary{lhs.subview(index, 160)}.to_Hex() << '\n';
+            }
+        }
+
+        const std::vector<std::pair<std::string, std::function<void()>>> benches{
+            { "hex_encode",         [&] { g_sink = g_sink + lhs.to_Hex().length(); } },
+            { "hex_decode",         [&] { g_sink = g_sink + lhs_Hex.to_Bin().length(); } },
+            { "hex_validate",       [&] { g_sink = g_sink + kim::sec::Hex{lhs_Hex_str}.length(); } },
+            { "b64_encode",         [&] { g_sink = g_sink + lhs.to_B64().length(); } },
+            { "b64_decode",         [&] { g_sink = g_sink + lhs_B64.to_Bin().length(); } },
+            { "b64_validate",       [&] { g_sink = g_sink + kim::sec::Base64{lhs_B64_str}.length(); } },
+            { "XOR",                [&] { g_sink = g_sink + kim::sec::XOR(lhs.view(), rhs.view()).length(); } },
+            { "XOR_Hex",            [&] { g_sink = g_sink + kim::sec::XOR<kim::sec::Hex, kim::sec::Hex>(lhs_Hex, lhs_Hex).length(); } },
+            { "Hamming",            [&] { g_sink = g_sink + kim::sec::Hamming(lhs.view(), rhs.view()); } },
+            { "XOR_byte_dec",       [&] { g_sink = g_sink + std::get<0>(kim::sec::XOR_byte_dec(byte_ct.view())); } },
+            { "XOR_rep_key_dec",    [&] { kim::sec::XOR_rep_key_dec<kim::sec::Hex>(kim::sec::FileSource{rep_in_name}, rep_out_name); } },
+            { "aes_ecb_enc",        [&] { g_sink = g_sink + kim::sec::aes_ecb_enc(aes_pt.view(), aes_key.view()).length(); } },
+            { "aes_ecb_dec",        [&] { g_sink = g_sink + kim::sec::aes_ecb_dec(aes_ct.view(), aes_key.view()).length(); } },
+            { "aes_ecb_dec_ctx",    [&] { g_sink = g_sink + kim::sec::aes_ecb_dec(aes_ct.view(), aes_context).length(); } },
+            { "XOR_batch",          [&] { g_sink = g_sink + kim::sec::XOR_batch(lhs_batch, rhs_batch).length(); } },
+            { "XOR_byte_dec_batch", [&] { g_sink = g_sink + kim::sec::XOR_byte_dec_batch(byte_ct_batch).size(); } },
+            { "aes_ecb_enc_batch",  [&] { g_sink = g_sink + kim::sec::aes_ecb_enc_batch(aes_pt.view(), aes_keys.view()).length(); } },
+            { "aes_ecb_detect",     [&] { g_sink = g_sink + kim::sec::aes_ecb_detect<kim::sec::Hex>(ecb_in_name).size(); } },
+        };
+
+        for (const auto& e : benches) {
+            if (opts.filter.empty() || e.first.find(opts.filter) != std::string::npos) {
+                std::cerr << e.first << " @ " << size << " B" << std::endl;
+                results.push_back(run(e.first, size, opts.min_time, e.second));
+            }
+        }
+    }
+
+    std::filesystem::remove(rep_in_name);
+    std::filesystem::remove(rep_out_name);
+    std::filesystem::remove(ecb_in_name);
+
+    print_json(results);
+
+    return 0;
+}
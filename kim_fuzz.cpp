@@ -0,0 +1,1205 @@
+/*
+ * @brief kim::sec Differential Fuzzer
+ * @author Edward Kim
+ *
+ * Usage: fuzz.out [--iterations N] [--seed N] [--max-size BYTES]
+ *
+ * Cross-checks the optimised codecs, validators, XOR kernels, formatting routines and AES paths against the
+ * plain scalar reference implementations below, on random inputs of random lengths at random alignments, and
+ * checks that the ECB byte-at-a-time and CBC padding oracle attacks recover the secrets they are given.
+ * Every iteration checks everything, so a run can be repeated exactly from its seed. Prints one line per check
+ * with the number of cases run, and the first mismatch of each failing check; exits with 1 if any check failed.
+ *
+ * "make fuzz" builds it with AddressSanitizer and UndefinedBehaviorSanitizer (BUILD=asan) and runs it with
+ * FUZZ_ARGS. Built with clang and -DKIM_FUZZ_LIBFUZZER -fsanitize=fuzzer it is a libFuzzer target instead,
+ * each input being checked as both bytes and text.
+ */
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <random>
+#include <optional>
+#include <functional>
+#include <algorithm>
+#include <bitset>
+#include <array>
+#include <stdexcept>
+
+#include <cstdlib>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+
+#include "kim_sec.hpp"
+
+namespace
+{
+    /*** Reporting ***/
+
+    struct check_stats
+    {
+        std::size_t     cases{};
+        std::size_t     failures{};
+        std::string     first_failure{};
+    };
+
+    std::map<std::string, check_stats> g_stats{};
+
+    /* Context of the case being checked, printed with the first failure of a check */
+    std::string g_case{};
+
+    void check(const std::string& p_name, const bool p_ok, const std::string& p_detail = "")
+    {
+        check_stats& stats{g_stats[p_name]};
+
+        stats.cases++;
+
+        if (!p_ok && stats.failures++ == 0) {
+            stats.first_failure = g_case + (p_detail.empty() ? "" : " " + p_detail);
+        }
+    }
+
+    std::string to_hex(const kim::sec::ByteView p_view)
+    {
+        static constexpr char digits[] = "0123456789ABCDEF";
+        std::string ret{};
+
+        for (const std::byte e : p_view) {
+            ret += digits[std::to_integer<uint8_t>(e) >> 4];
+            ret += digits[std::to_integer<uint8_t>(e) & 0xF];
+        }
+
+        return ret;
+    }
+
+    std::string to_hex(const std::string_view p_str)
+    {
+        return to_hex(kim::sec::ByteView{reinterpret_cast<const std::byte*>(p_str.data()), p_str.length()});
+    }
+
+    kim::sec::ByteView bytes(const std::vector<std::byte>& p_vec)
+    {
+        return kim::sec::ByteView{p_vec.data(), p_vec.size()};
+    }
+
+    bool equal(const kim::sec::ByteView lhs, const kim::sec::ByteView rhs)
+    {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    template <class Streamable>
+    std::string str(const Streamable& p_value)
+    {
+        std::ostringstream os{};
+        os << p_value;
+        return os.str();
+    }
+
+
+    /*** Reference Implementations: the textbook scalar algorithms, sharing no code with the library ***/
+
+    int ref_hex_value(const char p_chr)
+    {
+        if (p_chr >= '0' && p_chr <= '9') {
+            return p_chr - '0';
+        } else if (p_chr >= 'A' && p_chr <= 'F') {
+            return p_chr - 'A' + 10;
+        } else if (p_chr >= 'a' && p_chr <= 'f') {
+            return p_chr - 'a' + 10;
+        }
+
+        return -1;
+    }
+
+    std::string ref_hex_encode(const kim::sec::ByteView p_view)
+    {
+        return to_hex(p_view);
+    }
+
+    std::optional<std::vector<std::byte>> ref_hex_decode(const std::string_view p_text)
+    {
+        if (p_text.length() % 2 != 0) {
+            return std::nullopt;
+        }
+
+        std::vector<std::byte> ret{};
+
+        for (std::size_t index{}; index < p_text.length(); index += 2) {
+            const int hi{ref_hex_value(p_text[index])};
+            const int lo{ref_hex_value(p_text[index + 1])};
+
+            if (hi < 0 || lo < 0) {
+                return std::nullopt;
+            }
+
+            ret.push_back(static_cast<std::byte>(hi * 16 + lo));
+        }
+
+        return ret;
+    }
+
+    constexpr std::string_view ref_b64_alphabet{"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"};
+
+    std::string ref_b64_encode(const kim::sec::ByteView p_view)
+    {
+        std::string ret{};
+
+        for (std::size_t index{}; index < p_view.length(); index += 3) {
+            uint32_t    group{};
+            std::size_t count{std::min<std::size_t>(3, p_view.length() - index)};
+
+            for (std::size_t k{}; k < 3; k++) {
+                group = group << 8 | (k < count ? std::to_integer<uint32_t>(p_view[index + k]) : 0);
+            }
+
+            for (std::size_t k{}; k < 4; k++) {
+                ret += k <= count ? ref_b64_alphabet[(group >> (18 - 6 * k)) & 0x3F] : '=';
+            }
+        }
+
+        return ret;
+    }
+
+    /* Accepts unpadded or correctly padded text, ignoring the unused low bits of the last digit */
+    std::optional<std::vector<std::byte>> ref_b64_decode(const std::string_view p_text)
+    {
+        std::size_t body{p_text.length()};
+
+        while (body > 0 && p_text[body - 1] == '=') {
+            body--;
+        }
+
+        const std::size_t pad{p_text.length() - body};
+
+        if (body % 4 == 1 || pad > (4 - body % 4) % 4) {
+            return std::nullopt;
+        }
+
+        std::vector<std::byte>  ret{};
+        uint32_t                bits{};
+        unsigned                count{};
+
+        for (std::size_t index{}; index < body; index++) {
+            const std::size_t value{ref_b64_alphabet.find(p_text[index])};
+
+            if (value == std::string_view::npos) {
+                return std::nullopt;
+            }
+
+            bits = bits << 6 | static_cast<uint32_t>(value);
+            count += 6;
+
+            if (count >= 8) {
+                count -= 8;
+                ret.push_back(static_cast<std::byte>((bits >> count) & 0xFF));
+            }
+        }
+
+        return ret;
+    }
+
+    bool ref_is_space(const char p_chr)
+    {
+        return p_chr == ' ' || p_chr == '\t' || p_chr == '\n' || p_chr == '\r';
+    }
+
+    /* Returns { offset of the first bad character | bits read | whole bytes packed } */
+    std::tuple<std::size_t, std::size_t, std::vector<std::byte>> ref_bits_pack(const std::string_view p_text)
+    {
+        std::vector<std::byte>  out{};
+        std::size_t             bits{};
+        unsigned                acc{};
+        std::size_t             index{};
+
+        for (; index < p_text.length(); index++) {
+            if (ref_is_space(p_text[index])) {
+                continue;
+            }
+
+            if (p_text[index] != '0' && p_text[index] != '1') {
+                break;
+            }
+
+            acc = acc << 1 | static_cast<unsigned>(p_text[index] - '0');
+
+            if (++bits % 8 == 0) {
+                out.push_back(static_cast<std::byte>(acc & 0xFF));
+            }
+        }
+
+        return { index, bits, out };
+    }
+
+    std::size_t ref_pkcs7_pad_length(const kim::sec::ByteView p_block)
+    {
+        const std::size_t pad{std::to_integer<std::size_t>(p_block[p_block.length() - 1])};
+
+        if (pad == 0 || pad > p_block.length()) {
+            return 0;
+        }
+
+        for (std::size_t index{p_block.length() - pad}; index < p_block.length(); index++) {
+            if (std::to_integer<std::size_t>(p_block[index]) != pad) {
+                return 0;
+            }
+        }
+
+        return pad;
+    }
+
+    std::vector<std::byte> ref_xor_repeat(const kim::sec::ByteView p_msg, const kim::sec::ByteView p_key)
+    {
+        std::vector<std::byte> ret{};
+
+        for (std::size_t index{}; index < p_msg.length(); index++) {
+            ret.push_back(p_msg[index] ^ p_key[index % p_key.length()]);
+        }
+
+        return ret;
+    }
+
+    std::size_t ref_hamming(const kim::sec::ByteView lhs, const kim::sec::ByteView rhs)
+    {
+        std::size_t ret{};
+
+        for (std::size_t index{}; index < lhs.length(); index++) {
+            for (uint8_t diff{std::to_integer<uint8_t>(lhs[index] ^ rhs[index])}; diff; diff >>= 1) {
+                ret += diff & 1;
+            }
+        }
+
+        return ret;
+    }
+
+    /* Best English score over all 256 keys, 0 when none gives ASCII */
+    std::size_t ref_best_byte_score(const kim::sec::ByteView p_ct)
+    {
+        std::size_t ret{};
+
+        for (unsigned key{}; key < 256 && !p_ct.empty(); key++) {
+            std::size_t score{};
+            bool        ascii{true};
+
+            for (const std::byte e : p_ct) {
+                const uint8_t chr{static_cast<uint8_t>(std::to_integer<unsigned>(e) ^ key)};
+
+                ascii = ascii && chr < 128;
+                score += kim::sec::chr_score(chr);
+            }
+
+            ret = ascii ? std::max(ret, score) : ret;
+        }
+
+        return ret;
+    }
+
+    std::string ref_bits(const kim::sec::ByteView p_view)
+    {
+        std::string ret{};
+
+        for (std::size_t index{}; index < p_view.length(); index++) {
+            ret += (index ? " " : "") + std::bitset<8>(std::to_integer<unsigned>(p_view[index])).to_string();
+        }
+
+        return ret;
+    }
+
+    std::optional<std::string> ref_ascii(const kim::sec::ByteView p_view)
+    {
+        static const char* const names[] = { "NUL", "SOH", "STX", "ETX", "EOT", "ENQ", "ACK", "BEL", "BS", "HT", "LF", "VT", "FF", "CR", "SO", "SI",
+                                             "DLE", "DC1", "DC2", "DC3", "DC4", "NAK", "SYN", "ETB", "CAN", "EM", "SUB", "ESC", "FS", "GS", "RS", "US" };
+        std::string ret{};
+
+        for (const std::byte e : p_view) {
+            const unsigned chr{std::to_integer<unsigned>(e)};
+
+            if (chr > 127) {
+                return std::nullopt;
+            } else if (chr == '\n') {
+                ret += '\n';
+            } else if (chr < 32) {
+                ret += std::string{"("} + names[chr] + ")";
+            } else if (chr == 127) {
+                ret += "(DEL)";
+            } else {
+                ret += static_cast<char>(chr);
+            }
+        }
+
+        return ret;
+    }
+
+    /* hexdump -C -v */
+    std::string ref_hexdump(const kim::sec::ByteView p_view)
+    {
+        if (p_view.empty()) {
+            return "";
+        }
+
+        const int   width{p_view.length() > 0xFFFFFFFFULL ? 16 : 8};
+        std::string ret{};
+        char        buffer[32];
+
+        for (std::size_t line{}; line < p_view.length(); line += 16) {
+            std::snprintf(buffer, sizeof(buffer), "%0*zx ", width, line);
+            ret += buffer;
+
+            for (std::size_t index{}; index < 16; index++) {
+                ret += index % 8 == 0 ? " " : "";
+
+                if (line + index < p_view.length()) {
+                    std::snprintf(buffer, sizeof(buffer), "%02x ", std::to_integer<unsigned>(p_view[line + index]));
+                    ret += buffer;
+                } else {
+                    ret += "   ";
+                }
+            }
+
+            ret += " |";
+
+            for (std::size_t index{line}; index < std::min(line + 16, p_view.length()); index++) {
+                const unsigned chr{std::to_integer<unsigned>(p_view[index])};
+
+                ret += chr >= 0x20 && chr < 0x7F ? static_cast<char>(chr) : '.';
+            }
+
+            ret += "|\n";
+        }
+
+        std::snprintf(buffer, sizeof(buffer), "%0*zx\n", width, p_view.length());
+
+        return ret + buffer;
+    }
+
+    /* FIPS-197 byte by byte: S-box from the GF(2^8) inverse and affine map, round by round on a 4x4 state */
+    class RefAes
+    {
+    public:
+        explicit RefAes(const kim::sec::ByteView p_key) : m_rounds{p_key.length() / 4 + 6}
+        {
+            const std::size_t   nk{p_key.length() / 4};
+            uint8_t             rcon{1};
+
+            m_words.resize(4 * (m_rounds + 1));
+
+            for (std::size_t index{}; index < m_words.size(); index++) {
+                if (index < nk) {
+                    for (std::size_t k{}; k < 4; k++) {
+                        m_words[index][k] = std::to_integer<uint8_t>(p_key[4 * index + k]);
+                    }
+
+                    continue;
+                }
+
+                std::array<uint8_t, 4> temp{m_words[index - 1]};
+
+                if (index % nk == 0) {
+                    temp = { static_cast<uint8_t>(sbox()[temp[1]] ^ rcon), sbox()[temp[2]], sbox()[temp[3]], sbox()[temp[0]] };
+                    rcon = mul(rcon, 2);
+                } else if (nk > 6 && index % nk == 4) {
+                    for (uint8_t& e : temp) {
+                        e = sbox()[e];
+                    }
+                }
+
+                for (std::size_t k{}; k < 4; k++) {
+                    m_words[index][k] = m_words[index - nk][k] ^ temp[k];
+                }
+            }
+        }
+
+        void encrypt(const std::byte* p_in, std::byte* p_out) const
+        {
+            uint8_t state[16];
+
+            load(p_in, state);
+            add_round_key(state, 0);
+
+            for (std::size_t round{1}; round <= m_rounds; round++) {
+                for (uint8_t& e : state) {
+                    e = sbox()[e];
+                }
+
+                shift_rows(state, false);
+
+                if (round != m_rounds) {
+                    mix_columns(state, { 2, 3, 1, 1 });
+                }
+
+                add_round_key(state, round);
+            }
+
+            store(state, p_out);
+        }
+
+        void decrypt(const std::byte* p_in, std::byte* p_out) const
+        {
+            uint8_t state[16];
+
+            load(p_in, state);
+            add_round_key(state, m_rounds);
+
+            for (std::size_t round{m_rounds}; round-- > 0;) {
+                shift_rows(state, true);
+
+                for (uint8_t& e : state) {
+                    e = inv_sbox()[e];
+                }
+
+                add_round_key(state, round);
+
+                if (round != 0) {
+                    mix_columns(state, { 14, 11, 13, 9 });
+                }
+            }
+
+            store(state, p_out);
+        }
+
+    private:
+        static uint8_t mul(uint8_t p_lhs, uint8_t p_rhs)
+        {
+            uint8_t ret{};
+
+            for (; p_rhs; p_rhs >>= 1) {
+                ret ^= (p_rhs & 1) ? p_lhs : 0;
+                p_lhs = static_cast<uint8_t>((p_lhs << 1) ^ ((p_lhs & 0x80) ? 0x1B : 0));
+            }
+
+            return ret;
+        }
+
+        static const std::array<uint8_t, 256>& sbox()
+        {
+            static const std::array<uint8_t, 256> table{[] {
+                std::array<uint8_t, 256> ret{};
+
+                for (unsigned x{}; x < 256; x++) {
+                    unsigned inv{};
+
+                    while (x && mul(static_cast<uint8_t>(x), static_cast<uint8_t>(inv)) != 1) {
+                        inv++;
+                    }
+
+                    unsigned s{inv};
+
+                    for (unsigned shift{1}; shift <= 4; shift++) {
+                        s ^= ((inv << shift) | (inv >> (8 - shift))) & 0xFF;
+                    }
+
+                    ret[x] = static_cast<uint8_t>(s ^ 0x63);
+                }
+
+                return ret;
+            }()};
+
+            return table;
+        }
+
+        static const std::array<uint8_t, 256>& inv_sbox()
+        {
+            static const std::array<uint8_t, 256> table{[] {
+                std::array<uint8_t, 256> ret{};
+
+                for (unsigned x{}; x < 256; x++) {
+                    ret[sbox()[x]] = static_cast<uint8_t>(x);
+                }
+
+                return ret;
+            }()};
+
+            return table;
+        }
+
+        static void load(const std::byte* p_in, uint8_t* p_state)
+        {
+            for (std::size_t index{}; index < 16; index++) {
+                p_state[index] = std::to_integer<uint8_t>(p_in[index]);
+            }
+        }
+
+        static void store(const uint8_t* p_state, std::byte* p_out)
+        {
+            for (std::size_t index{}; index < 16; index++) {
+                p_out[index] = static_cast<std::byte>(p_state[index]);
+            }
+        }
+
+        /* Byte c * 4 + r of the block is row r of column c */
+        static void shift_rows(uint8_t* p_state, const bool p_inverse)
+        {
+            uint8_t copy[16];
+
+            std::copy(p_state, p_state + 16, copy);
+
+            for (std::size_t row{1}; row < 4; row++) {
+                for (std::size_t column{}; column < 4; column++) {
+                    const std::size_t from{p_inverse ? (column + 4 - row) % 4 : (column + row) % 4};
+
+                    p_state[column * 4 + row] = copy[from * 4 + row];
+                }
+            }
+        }
+
+        static void mix_columns(uint8_t* p_state, const std::array<uint8_t, 4> p_coefficients)
+        {
+            for (std::size_t column{}; column < 4; column++) {
+                uint8_t* const  col{p_state + column * 4};
+                const uint8_t   copy[4]{ col[0], col[1], col[2], col[3] };
+
+                for (std::size_t row{}; row < 4; row++) {
+                    col[row] = 0;
+
+                    for (std::size_t k{}; k < 4; k++) {
+                        col[row] ^= mul(copy[k], p_coefficients[(k + 4 - row) % 4]);
+                    }
+                }
+            }
+        }
+
+        void add_round_key(uint8_t* p_state, const std::size_t p_round) const
+        {
+            for (std::size_t index{}; index < 16; index++) {
+                p_state[index] ^= m_words[p_round * 4 + index / 4][index % 4];
+            }
+        }
+
+        std::size_t                             m_rounds;
+        std::vector<std::array<uint8_t, 4>>     m_words{};
+    };
+
+    std::size_t ref_ecb_repeats(const kim::sec::ByteView p_ct)
+    {
+        std::size_t ret{};
+
+        for (std::size_t index{1}; index < p_ct.length() / 16; index++) {
+            for (std::size_t earlier{}; earlier < index; earlier++) {
+                if (equal(p_ct.subview(index * 16, 16), p_ct.subview(earlier * 16, 16))) {
+                    ret++;
+                    break;
+                }
+            }
+        }
+
+        return ret;
+    }
+
+
+    /*** Input Generation ***/
+
+    using rng_t = std::mt19937_64;
+
+    /* Bytes at a random offset from a 16 byte boundary, the buffer kept alive by p_storage */
+    kim::sec::ByteView random_bytes(rng_t& p_rng, const std::size_t p_length, std::vector<std::byte>& p_storage)
+    {
+        const std::size_t offset{p_rng() % 16};
+
+        p_storage.resize(offset + p_length);
+
+        for (std::byte& e : p_storage) {
+            e = static_cast<std::byte>(p_rng());
+        }
+
+        return kim::sec::ByteView{p_storage.data() + offset, p_length};
+    }
+
+    /* Text at a random offset, the buffer kept alive by p_storage */
+    std::string_view misalign(rng_t& p_rng, const std::string& p_text, std::string& p_storage)
+    {
+        const std::size_t offset{p_rng() % 16};
+
+        p_storage.assign(offset, '#');
+        p_storage += p_text;
+
+        return std::string_view{p_storage}.substr(offset);
+    }
+
+    /* Replaces a random character with one from p_chars */
+    void mutate(rng_t& p_rng, std::string& p_text, const std::string_view p_chars)
+    {
+        if (!p_text.empty()) {
+            p_text[p_rng() % p_text.length()] = p_chars[p_rng() % p_chars.length()];
+        }
+    }
+
+
+    /*** Checks ***/
+
+    void check_hex(rng_t& p_rng, const kim::sec::ByteView p_data, std::string p_text)
+    {
+        std::string storage{};
+
+        /* Hex text: random case, sometimes a bad character or an odd length */
+        std::string text{ref_hex_encode(p_data)};
+
+        for (char& e : text) {
+            e = (p_rng() & 1) ? static_cast<char>(std::tolower(static_cast<unsigned char>(e))) : e;
+        }
+
+        if (p_rng() % 4 == 0) {
+            mutate(p_rng, text, "0123456789abcdefABCDEFgG xZ\n=");
+        }
+
+        if (p_rng() % 8 == 0 && !text.empty()) {
+            text.pop_back();
+        }
+
+        for (const std::string& input : { text, p_text }) {
+            const std::string_view  view{misalign(p_rng, input, storage)};
+            std::string             upper(view.length(), '\0');
+            std::size_t             ref_bad{};
+
+            while (ref_bad < view.length() && ref_hex_value(view[ref_bad]) >= 0) {
+                ref_bad++;
+            }
+
+            const std::size_t bad{kim::sec::detail::hex_copy_upper(view.data(), view.length(), upper.data())};
+            std::string       ref_upper{view.substr(0, ref_bad)};
+
+            std::transform(ref_upper.begin(), ref_upper.end(), ref_upper.begin(), [](const char e) { return static_cast<char>(std::toupper(static_cast<unsigned char>(e))); });
+
+            check("hex_copy_upper", bad == ref_bad && upper.compare(0, ref_bad, ref_upper) == 0, "text " + to_hex(view));
+
+            const auto ref{ref_hex_decode(view)};
+
+            try {
+                const kim::sec::Hex     hex{view, std::pmr::get_default_resource()};
+                const kim::sec::Binary  bin{hex.to_Bin()};
+
+                check("Hex_parse", ref && equal(bin.view(), bytes(*ref)), "text " + to_hex(view));
+            } catch (const std::invalid_argument&) {
+                check("Hex_parse", !ref, "text " + to_hex(view));
+            }
+        }
+
+        const kim::sec::Binary bin{p_data};
+
+        check("Binary_to_Hex", str(bin.to_Hex()) == ref_hex_encode(p_data), "data " + to_hex(p_data));
+        check("Hex_round_trip", equal(kim::sec::Hex{bin}.to_Bin().view(), p_data), "data " + to_hex(p_data));
+    }
+
+    void check_b64(rng_t& p_rng, const kim::sec::ByteView p_data, std::string p_text)
+    {
+        std::string storage{};
+
+        /* Base64 text: sometimes unpadded, over-padded, or with a bad character */
+        std::string text{ref_b64_encode(p_data)};
+
+        switch (p_rng() % 8) {
+            case 0:
+                text.erase(text.find_last_not_of('=') + 1);
+                break;
+            case 1:
+                text += '=';
+                break;
+            case 2:
+                mutate(p_rng, text, "AZaz09+/=-_ \n");
+                break;
+            default:
+                break;
+        }
+
+        for (const std::string& input : { text, p_text }) {
+            const std::string_view  view{misalign(p_rng, input, storage)};
+            const std::size_t       ref_bad{std::min(view.find_first_not_of(ref_b64_alphabet), view.length())};
+
+            check("b64_find_invalid", kim::sec::detail::b64_find_invalid(view.data(), view.length()) == ref_bad, "text " + to_hex(view));
+
+            const auto ref{ref_b64_decode(view)};
+
+            try {
+                const kim::sec::Base64  b64{view, std::pmr::get_default_resource()};
+                const kim::sec::Binary  bin{b64.to_Bin()};
+
+                /* The digits are kept as given, including unused low bits, and padded to whole groups */
+                const std::string digits{view.substr(0, view.find_last_not_of('=') + 1)};
+
+                check("Base64_parse", ref && equal(bin.view(), bytes(*ref)), "text " + to_hex(view));
+                check("Base64_print", str(b64) == digits + std::string((4 - digits.length() % 4) % 4, '='), "text " + to_hex(view));
+            } catch (const std::invalid_argument&) {
+                check("Base64_parse", !ref, "text " + to_hex(view));
+            }
+        }
+
+        const kim::sec::Binary bin{p_data};
+
+        check("Binary_to_B64", str(bin.to_B64()) == ref_b64_encode(p_data), "data " + to_hex(p_data));
+
+        /* Appending bytes in random pieces matches encoding them at once */
+        {
+            kim::sec::Base64 pieces{};
+
+            for (std::size_t pos{}; pos < p_data.length();) {
+                const std::size_t length{std::min<std::size_t>(p_rng() % 8, p_data.length() - pos)};
+
+                pieces.append(p_data.subview(pos, length));
+                pos += length;
+            }
+
+            check("Base64_append_bytes", str(pieces) == ref_b64_encode(p_data) && pieces.length() == ref_b64_encode(p_data).length(),
+                  "data " + to_hex(p_data));
+        }
+
+        /* Appending digits in random pieces fails exactly when the digits so far would end in a lone digit */
+        {
+            const std::string   digits{text.substr(0, text.find_first_of('='))};
+            kim::sec::Base64    pieces{};
+            std::string         accepted{};
+            bool                ok{true};
+
+            for (std::size_t pos{}; pos < digits.length();) {
+                const std::string   piece{digits.substr(pos, 1 + p_rng() % 9)};
+                const bool          ref_ok{piece.find_first_not_of(ref_b64_alphabet) == std::string::npos
+                                           && (accepted.length() + piece.length()) % 4 != 1};
+
+                try {
+                    pieces.append(piece);
+                    ok = ok && ref_ok;
+                    accepted += piece;
+                } catch (const std::invalid_argument&) {
+                    ok = ok && !ref_ok;
+                }
+
+                pos += piece.length();
+            }
+
+            const auto ref{ref_b64_decode(accepted)};
+
+            check("Base64_append_text", ok && ref && equal(pieces.to_Bin().view(), bytes(*ref)), "text " + to_hex(digits));
+        }
+    }
+
+    void check_bits(rng_t& p_rng, const kim::sec::ByteView p_data, std::string p_text)
+    {
+        std::string storage{};
+
+        /* Bit strings with random whitespace, sometimes a stray character */
+        std::string text{};
+
+        for (const std::byte e : p_data) {
+            for (const char chr : std::bitset<8>(std::to_integer<unsigned>(e)).to_string()) {
+                text += chr;
+
+                if (p_rng() % 16 == 0) {
+                    text += " \t\n\r"[p_rng() % 4];
+                }
+            }
+        }
+
+        if (p_rng() % 4 == 0) {
+            mutate(p_rng, text, "01 2x\n\xC3");
+        }
+
+        if (p_rng() % 8 == 0 && !text.empty()) {
+            text.pop_back();
+        }
+
+        for (const std::string& input : { text, p_text }) {
+            const std::string_view          view{misalign(p_rng, input, storage)};
+            std::vector<std::byte>          out(view.length() / 8 + 1);
+            std::size_t                     bits{};
+            const std::size_t               bad{kim::sec::detail::bits_pack(view.data(), view.length(), out.data(), bits)};
+            const auto                      [ref_bad, ref_bits, ref_out]{ref_bits_pack(view)};
+
+            check("bits_pack", bad == ref_bad && bits == ref_bits && equal(kim::sec::ByteView{out.data(), bits / 8}, bytes(ref_out)),
+                  "text " + to_hex(view));
+
+            try {
+                const kim::sec::Binary bin{std::string{view}};
+
+                /* Anything but bits and whitespace makes the string ASCII */
+                const bool ascii{ref_bad != view.length()};
+
+                check("Binary_parse", ascii ? equal(bin.view(), kim::sec::ByteView{reinterpret_cast<const std::byte*>(view.data()), view.length()})
+                                            : ref_bits % 8 == 0 && equal(bin.view(), bytes(ref_out)),
+                      "text " + to_hex(view));
+            } catch (const std::invalid_argument&) {
+                /* Neither bits nor ASCII */
+                const bool non_ascii{std::any_of(view.begin(), view.end(), [](const char e) { return (e & 0x80) != 0; })};
+
+                check("Binary_parse", ref_bad == view.length() ? ref_bits % 8 != 0 : non_ascii, "text " + to_hex(view));
+            }
+        }
+    }
+
+    void check_pkcs7(rng_t& p_rng, const kim::sec::ByteView p_data)
+    {
+        if (p_data.empty() || p_data.length() > 255) {
+            return;
+        }
+
+        /* Random tails, or valid padding with sometimes one byte changed */
+        std::vector<std::byte> block{p_data.begin(), p_data.end()};
+
+        if (p_rng() & 1) {
+            const std::size_t pad{1 + p_rng() % block.size()};
+
+            std::fill(block.end() - static_cast<std::ptrdiff_t>(pad), block.end(), static_cast<std::byte>(pad));
+
+            if (p_rng() % 4 == 0) {
+                block[block.size() - 1 - p_rng() % pad] ^= std::byte{1};
+            }
+        }
+
+        check("pkcs7_pad_length", kim::sec::detail::pkcs7_pad_length(block.data(), block.size()) == ref_pkcs7_pad_length(bytes(block)),
+              "block " + to_hex(bytes(block)));
+    }
+
+    void check_xor(rng_t& p_rng, const kim::sec::ByteView p_data)
+    {
+        std::vector<std::byte>      storage{};
+        const kim::sec::ByteView    other{random_bytes(p_rng, p_data.length(), storage)};
+
+        check("XOR", equal(kim::sec::XOR(p_data, other).view(), bytes(ref_xor_repeat(p_data, other.empty() ? p_data : other))),
+              "lhs " + to_hex(p_data));
+
+        if (!p_data.empty()) {
+            check("XOR_byte", equal(kim::sec::XOR(p_data, other.subview(0, 1)).view(), bytes(ref_xor_repeat(p_data, other.subview(0, 1)))),
+                  "lhs " + to_hex(p_data));
+        }
+
+        check("XOR_Hex", equal(kim::sec::XOR<kim::sec::Hex, kim::sec::Hex>(kim::sec::Hex{kim::sec::Binary{p_data}},
+                                                                           kim::sec::Hex{kim::sec::Binary{other}}).view(),
+                               kim::sec::XOR(p_data, other).view()),
+              "lhs " + to_hex(p_data));
+
+        check("Hamming", kim::sec::Hamming(p_data, other) == ref_hamming(p_data, other), "lhs " + to_hex(p_data));
+
+        /* Batches of random records, with keys repeating over their messages */
+        const std::size_t           count{1 + p_rng() % 8};
+        std::vector<std::byte>      msgs{};
+        std::vector<std::byte>      keys{};
+        std::vector<std::size_t>    msg_offsets{0};
+        std::vector<std::size_t>    key_offsets{0};
+
+        for (std::size_t index{}; index < count; index++) {
+            const kim::sec::ByteView msg{p_data.subview(p_rng() % (p_data.length() + 1), p_rng() % 40)};
+            const kim::sec::ByteView key{random_bytes(p_rng, 1 + p_rng() % 24, storage)};
+
+            msgs.insert(msgs.end(), msg.begin(), msg.end());
+            keys.insert(keys.end(), key.begin(), key.end());
+            msg_offsets.push_back(msgs.size());
+            key_offsets.push_back(keys.size());
+        }
+
+        const kim::sec::BatchView   msg_batch{bytes(msgs), msg_offsets.data(), count};
+        const kim::sec::BatchView   key_batch{bytes(keys), key_offsets.data(), count};
+        std::vector<std::byte>      expected{};
+
+        for (std::size_t index{}; index < count; index++) {
+            const std::vector<std::byte> record{ref_xor_repeat(msg_batch[index], key_batch[index])};
+
+            expected.insert(expected.end(), record.begin(), record.end());
+        }
+
+        check("XOR_batch", equal(kim::sec::XOR_batch(msg_batch, key_batch).view(), bytes(expected)), "msgs " + to_hex(bytes(msgs)));
+    }
+
+    void check_byte_dec(rng_t& p_rng, const kim::sec::ByteView p_data)
+    {
+        /* English-like text under one key, or the raw bytes */
+        static const std::string    corpus{"Cooking MC's like a pound of bacon, the quick brown fox jumps over the lazy dog. "};
+        const std::size_t           length{std::min<std::size_t>(p_data.length(), 300)};
+        std::vector<std::byte>      ct{p_data.begin(), p_data.begin() + static_cast<std::ptrdiff_t>(length)};
+
+        if (p_rng() & 1) {
+            const std::byte key{static_cast<std::byte>(p_rng())};
+
+            for (std::size_t index{}; index < ct.size(); index++) {
+                ct[index] = static_cast<std::byte>(corpus[(index + p_rng() % 2) % corpus.length()]) ^ key;
+            }
+        }
+
+        const std::size_t   ref_score{ref_best_byte_score(bytes(ct))};
+        const auto          single{kim::sec::XOR_byte_dec(bytes(ct))};
+        const auto          batch{kim::sec::XOR_byte_dec_batch(kim::sec::BatchView{bytes(ct), ct.empty() ? 1 : ct.size()})};
+
+        check("XOR_byte_dec", std::get<0>(single) == ref_score, "ct " + to_hex(bytes(ct)));
+
+        if (!ct.empty()) {
+            /* The batch key must reach the best score, whichever of several tied keys it picks */
+            std::size_t key_score{};
+
+            for (const std::byte e : ct) {
+                key_score += kim::sec::chr_score(std::to_integer<uint8_t>(e ^ batch[0].second));
+            }
+
+            check("XOR_byte_dec_batch", batch[0].first == ref_score && (ref_score == 0 || key_score == ref_score), "ct " + to_hex(bytes(ct)));
+
+            /* Both break ties by the smallest byte, so they agree on the key whenever one gives ASCII */
+            check("XOR_byte_dec_key", ref_score == 0 || std::get<2>(single)[0] == batch[0].second, "ct " + to_hex(bytes(ct)));
+        }
+    }
+
+    void check_format(rng_t& p_rng, const kim::sec::ByteView p_data)
+    {
+        /* Mostly ASCII so that format_ascii has something to render */
+        std::vector<std::byte> ascii{p_data.begin(), p_data.end()};
+
+        if (p_rng() & 1) {
+            for (std::byte& e : ascii) {
+                e &= std::byte{0x7F};
+            }
+        }
+
+        check("format_bits", kim::sec::format_bits(p_data) == ref_bits(p_data), "data " + to_hex(p_data));
+        check("write_bits", str([&] { std::ostringstream os{}; kim::sec::write_bits(os, p_data); return os.str(); }()) == ref_bits(p_data),
+              "data " + to_hex(p_data));
+
+        const auto ref_ascii_str{ref_ascii(bytes(ascii))};
+
+        check("format_ascii", ref_ascii_str ? kim::sec::format_ascii(bytes(ascii)) == *ref_ascii_str
+                                              && kim::sec::ascii_length(bytes(ascii)) == ref_ascii_str->length()
+                                            : kim::sec::ascii_length(bytes(ascii)) == std::string::npos,
+              "data " + to_hex(bytes(ascii)));
+
+        const std::string ref_dump{ref_hexdump(p_data)};
+
+        check("format_hexdump", kim::sec::format_hexdump(p_data) == ref_dump && kim::sec::hexdump_length(p_data.length()) == ref_dump.length(),
+              "data " + to_hex(p_data));
+        check("write_hexdump", [&] { std::ostringstream os{}; kim::sec::write_hexdump(os, p_data); return os.str(); }() == ref_dump,
+              "data " + to_hex(p_data));
+    }
+
+    void check_aes(rng_t& p_rng, const kim::sec::ByteView p_data)
+    {
+        std::vector<std::byte>      key_storage{};
+        std::vector<std::byte>      iv_storage{};
+        const std::size_t           key_length{16 + 8 * (p_rng() % 3)};
+        const kim::sec::ByteView    key{random_bytes(p_rng, key_length, key_storage)};
+        const kim::sec::ByteView    iv{random_bytes(p_rng, 16, iv_storage)};
+        const kim::sec::ByteView    pt{p_data.subview(0, p_data.length() / 16 * 16)};
+        const RefAes                ref{key};
+        const kim::sec::AesContext  context{key};
+        std::vector<std::byte>      ref_ecb(pt.length());
+        std::vector<std::byte>      ref_cbc(pt.length());
+
+        for (std::size_t index{}; index < pt.length(); index += 16) {
+            ref.encrypt(pt.data() + index, ref_ecb.data() + index);
+
+            std::byte block[16];
+
+            for (std::size_t k{}; k < 16; k++) {
+                block[k] = pt[index + k] ^ (index ? ref_cbc[index - 16 + k] : iv[k]);
+            }
+
+            ref.encrypt(block, ref_cbc.data() + index);
+        }
+
+        const std::string context_str{"key " + to_hex(key) + " pt " + to_hex(pt)};
+
+        check("aes_ecb_enc", equal(kim::sec::aes_ecb_enc(pt, key).view(), bytes(ref_ecb)), context_str);
+        check("aes_ecb_enc_ctx", equal(kim::sec::aes_ecb_enc(pt, context).view(), bytes(ref_ecb)), context_str);
+        check("aes_ecb_dec", equal(kim::sec::aes_ecb_dec(bytes(ref_ecb), key).view(), pt), context_str);
+        check("aes_ecb_dec_ctx", equal(kim::sec::aes_ecb_dec(bytes(ref_ecb), context).view(), pt), context_str);
+        check("aes_cbc_enc", equal(kim::sec::aes_cbc_enc(pt, key, iv).view(), bytes(ref_cbc)), context_str);
+        check("aes_cbc_dec", equal(kim::sec::aes_cbc_dec(bytes(ref_cbc), context, iv).view(), pt), context_str);
+
+        if (!pt.empty()) {
+            std::vector<std::byte> ref_dec(16);
+
+            ref.decrypt(pt.data(), ref_dec.data());
+            check("aes_block_dec", equal(kim::sec::aes_ecb_dec(pt.subview(0, 16), key).view(), bytes(ref_dec)), context_str);
+        }
+
+        /* AES-128 batches under one shared key or a key per block */
+        const kim::sec::ByteView    key128{key.subview(0, 16)};
+        const RefAes                ref128{key128};
+        std::vector<std::byte>      keys_storage{};
+        const kim::sec::ByteView    keys{random_bytes(p_rng, pt.length(), keys_storage)};
+        std::vector<std::byte>      ref_shared(pt.length());
+        std::vector<std::byte>      ref_each(pt.length());
+
+        for (std::size_t index{}; index < pt.length(); index += 16) {
+            ref128.encrypt(pt.data() + index, ref_shared.data() + index);
+            RefAes{keys.subview(index, 16)}.encrypt(pt.data() + index, ref_each.data() + index);
+        }
+
+        check("aes_ecb_enc_batch", equal(kim::sec::aes_ecb_enc_batch(pt, key128).view(), bytes(ref_shared))
+                                   && equal(kim::sec::aes_ecb_enc_batch(pt, keys).view(), bytes(ref_each)), context_str);
+
+        /* Ciphertexts with planted repeated blocks */
+        std::vector<std::byte> ct{ref_ecb};
+
+        for (std::size_t count{p_rng() % 4}; count > 0 && ct.size() >= 32; count--) {
+            const std::size_t from{p_rng() % (ct.size() / 16)};
+            const std::size_t to{p_rng() % (ct.size() / 16)};
+
+            std::copy_n(ct.begin() + static_cast<std::ptrdiff_t>(from * 16), 16, ct.begin() + static_cast<std::ptrdiff_t>(to * 16));
+        }
+
+        check("aes_ecb_repeats", kim::sec::aes_ecb_repeats(bytes(ct)) == ref_ecb_repeats(bytes(ct)), "ct " + to_hex(bytes(ct)));
+    }
+
+    /* The attacks recover a known secret and plaintext from their oracles, and give up promptly when an oracle fails */
+    void check_attacks(rng_t& p_rng, const kim::sec::ByteView p_data)
+    {
+        std::vector<std::byte>      prefix_storage{};
+        const kim::sec::ByteView    secret{p_data.subview(0, std::min<std::size_t>(p_data.length(), 48))};
+        const kim::sec::ByteView    prefix{random_bytes(p_rng, p_rng() % 40, prefix_storage)};
+        const std::size_t           threads{1 + p_rng() % 3};
+        const std::string           context_str{"secret " + to_hex(secret) + " prefix " + to_hex(prefix)};
+
+        try {
+            kim::sec::EcbOracle ecb_oracle{secret, prefix};
+
+            check("ecb_byte_at_a_time", equal(kim::sec::ecb_byte_at_a_time(ecb_oracle).view(), secret), context_str);
+        } catch (const std::exception& e) {
+            check("ecb_byte_at_a_time", false, context_str + " threw " + e.what());
+        }
+
+        const kim::sec::CbcOracle cbc_oracle{};
+        const auto [iv, ct] = cbc_oracle.encrypt(secret);
+
+        try {
+            kim::sec::Binary padded{secret};
+
+            check("cbc_padding_oracle", equal(kim::sec::cbc_padding_oracle(cbc_oracle, iv.view(), ct.view(), threads).view(), padded.pkcs7_pad().view()),
+                  context_str + " threads " + std::to_string(threads));
+        } catch (const std::exception& e) {
+            check("cbc_padding_oracle", false, context_str + " threw " + e.what());
+        }
+
+        /* An oracle rejecting everything fails the first block after 256 guesses, on one thread the rest are never tried */
+        std::size_t queries{};
+        bool        thrown{};
+
+        try {
+            kim::sec::cbc_padding_oracle([&queries](const kim::sec::ByteView, const kim::sec::ByteView) { queries++; return false; },
+                                         iv.view(), ct.view(), 1);
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+
+        check("cbc_padding_oracle_stop", thrown && queries == 256, context_str + " queries " + std::to_string(queries));
+
+        /* An oracle throwing on some query surfaces its error with the outstanding blocks abandoned, unless the attack finished first */
+        const std::size_t fail_at{1 + p_rng() % (ct.length() * 16)};
+
+        queries = 0;
+        thrown = false;
+
+        try {
+            kim::sec::cbc_padding_oracle([&](const kim::sec::ByteView p_iv, const kim::sec::ByteView p_ct) {
+                if (++queries == fail_at) {
+                    throw std::runtime_error("oracle failed");
+                }
+
+                return cbc_oracle(p_iv, p_ct);
+            }, iv.view(), ct.view(), 1);
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+
+        check("cbc_padding_oracle_throw", thrown ? queries == fail_at : queries < fail_at, context_str + " fail_at " + std::to_string(fail_at)
+                                                                         + " queries " + std::to_string(queries));
+    }
+
+    /* Runs every check on one input, auxiliary choices (keys, splits, mutations) coming from p_rng */
+    void fuzz_one(rng_t& p_rng, const kim::sec::ByteView p_data, const std::string& p_text)
+    {
+        check_hex(p_rng, p_data, p_text);
+        check_b64(p_rng, p_data, p_text);
+        check_bits(p_rng, p_data, p_text);
+        check_pkcs7(p_rng, p_data);
+        check_xor(p_rng, p_data);
+        check_byte_dec(p_rng, p_data);
+        check_format(p_rng, p_data);
+        check_aes(p_rng, p_data);
+        check_attacks(p_rng, p_data);
+    }
+}
+
+#if defined(KIM_FUZZ_LIBFUZZER)
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* p_data, const std::size_t p_size)
+{
+    const std::string_view  text{reinterpret_cast<const char*>(p_data), p_size};
+    rng_t                   rng{std::hash<std::string_view>{}(text)};
+
+    g_case = "input " + to_hex(text);
+    fuzz_one(rng, kim::sec::ByteView{reinterpret_cast<const std::byte*>(p_data), p_size}, std::string{text});
+
+    for (const auto& e : g_stats) {
+        if (e.second.failures) {
+            std::cerr << e.first << " FAILED: " << e.second.first_failure << std::endl;
+            std::abort();
+        }
+    }
+
+    return 0;
+}
+
+#else
+
+/* Mostly short lengths, where the vector loops hand over to their tails, sometimes up to the maximum */
+static std::size_t random_length(rng_t& p_rng, const std::size_t p_max)
+{
+    const std::size_t roll{p_rng() % 10};
+
+    return std::min(p_max, roll < 5 ? p_rng() % 65 : roll < 9 ? p_rng() % 513 : p_rng() % (p_max + 1));
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t     iterations{2000};
+    std::uint64_t   seed{0x6B696D};
+    std::size_t     max_size{4096};
+
+    for (int index{1}; index < argc; index++) {
+        const std::string arg{argv[index]};
+
+        if (index + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return 1;
+        } else if (arg == "--iterations") {
+            iterations = std::stoull(argv[++index]);
+        } else if (arg == "--seed") {
+            seed = std::stoull(argv[++index]);
+        } else if (arg == "--max-size") {
+            max_size = std::stoull(argv[++index]);
+        } else {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    rng_t rng{seed};
+
+    for (std::size_t iteration{}; iteration < iterations; iteration++) {
+        std::vector<std::byte>      storage{};
+        const kim::sec::ByteView    data{random_bytes(rng, random_length(rng, max_size), storage)};
+
+        /* Random printable text with some whitespace, for the parsers' error paths */
+        std::string text(random_length(rng, max_size), '\0');
+
+        for (char& e : text) {
+            e = static_cast<char>(rng() % 8 == 0 ? " \n0123456789abcdefABCDEF=+/"[rng() % 27] : 32 + rng() % 95);
+        }
+
+        g_case = "seed " + std::to_string(seed) + " iteration " + std::to_string(iteration);
+        fuzz_one(rng, data, text);
+    }
+
+    std::size_t failed{};
+
+    for (const auto& e : g_stats) {
+        std::cout << e.first << ": " << e.second.cases << " cases";
+
+        if (e.second.failures) {
+            std::cout << ", " << e.second.failures << " FAILED, first at " << e.second.first_failure.substr(0, 400);
+            failed++;
+        }
+
+        std::cout << '\n';
+    }
+
+    std::cout << (failed ? std::to_string(failed) + " checks failed" : "All checks passed") << std::endl;
+
+    return failed ? 1 : 0;
+}
+
+#endif
@@ -8,5 +8,6 @@
 #include "sec_types.hpp"
 #include "sec_xor.hpp"
 #include "sec_aes.hpp"
+#include "sec_attack.hpp"
 
 #endif /* KIM_SEC */
@@ -0,0 +1,1181 @@
+/*
+ * @brief kim::sec Unit Tests
+ * @author Edward Kim
+ *
+ * Usage: tests.out
+ *
+ * Checks the library behaviour the differential fuzzer cannot reach from random inputs: file input and output,
+ * checkpoints, caches, instrumentation and the contracts of the public entry points. Every test works in its own
+ * directory under the system temporary directory. Prints one line per check with the number of cases run and the
+ * first failure of each failing check; exits with 1 if any check failed.
+ *
+ * "make check" builds and runs it.
+ */
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <array>
+#include <tuple>
+#include <optional>
+#include <memory>
+#include <future>
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <random>
+#include <thread>
+#include <chrono>
+#include <stdexcept>
+
+#include <cstddef>
+#include <csignal>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "kim_sec.hpp"
+
+namespace
+{
+    /*** Reporting ***/
+
+    struct check_stats
+    {
+        std::size_t     cases{};
+        std::size_t     failures{};
+        std::string     first_failure{};
+    };
+
+    std::map<std::string, check_stats> g_stats{};
+
+    void check(const std::string& p_name, const bool p_ok, const std::string& p_detail = "")
+    {
+        check_stats& stats{g_stats[p_name]};
+
+        stats.cases++;
+
+        if (!p_ok && stats.failures++ == 0) {
+            stats.first_failure = p_detail.empty() ? "failed" : p_detail;
+        }
+    }
+
+    /* Runs p_body, recording an exception it throws as a failure of p_name */
+    void guarded(const std::string& p_name, const std::function<void()>& p_body)
+    {
+        try {
+            p_body();
+        } catch (const std::exception& e) {
+            check(p_name, false, std::string("threw ") + e.what());
+        }
+    }
+
+
+    /*** Fixtures ***/
+
+    /* Directory removed with everything in it when the test is done */
+    class TempDir
+    {
+    public:
+        explicit TempDir(const std::string& p_name) : m_path{std::filesystem::temp_directory_path() / ("kim_tests_" + p_name)}
+        {
+            std::filesystem::remove_all(m_path);
+            std::filesystem::create_directories(m_path);
+        }
+
+        TempDir(const TempDir&) = delete;
+        TempDir& operator=(const TempDir&) = delete;
+
+        ~TempDir()
+        {
+            std::error_code error{};
+            std::filesystem::remove_all(m_path, error);
+        }
+
+        /* Returns the path of a file in the directory */
+        std::string file(const std::string& p_name) const
+        {
+            return (m_path / p_name).string();
+        }
+
+    private:
+        std::filesystem::path m_path;
+    };
+
+    void write_file(const std::string& p_path, const std::string_view p_data)
+    {
+        std::ofstream out{p_path, std::ios::binary | std::ios::trunc};
+        out.write(p_data.data(), static_cast<std::streamsize>(p_data.length()));
+    }
+
+    std::string read_file(const std::string& p_path)
+    {
+        std::ifstream       in{p_path, std::ios::binary};
+        std::ostringstream  os{};
+
+        os << in.rdbuf();
+
+        return os.str();
+    }
+
+    /* Repeating-key XOR encryption of English text, hex encoded */
+    std::string rep_key_hex(const std::string_view p_pt, const std::string_view p_key)
+    {
+        std::string ct(p_pt);
+
+        for (std::size_t index{}; index < ct.length(); index++) {
+            ct[index] = static_cast<char>(ct[index] ^ p_key[index % p_key.length()]);
+        }
+
+        std::ostringstream os{};
+        os << kim::sec::Binary{kim::sec::ByteView{reinterpret_cast<const std::byte*>(ct.data()), ct.length()}}.to_Hex();
+
+        return os.str();
+    }
+
+    /* Runs p_body in a child process and kills it once p_ready holds
+     * - Returns true if the child was killed, false if it finished (or failed) first
+     */
+    bool kill_partway(const std::function<void()>& p_body, const std::function<bool()>& p_ready)
+    {
+        std::cout.flush();
+
+        const pid_t pid{::fork()};
+
+        if (pid == 0) {
+            try {
+                p_body();
+            } catch (...) {
+                ::_exit(2);
+            }
+
+            ::_exit(0);
+        }
+
+        int status{};
+
+        while (!p_ready()) {
+            if (::waitpid(pid, &status, WNOHANG) == pid) {
+                return false;
+            }
+
+            std::this_thread::sleep_for(std::chrono::microseconds{200});
+        }
+
+        ::kill(pid, SIGKILL);
+        ::waitpid(pid, &status, 0);
+
+        return WIFSIGNALED(status) && WTERMSIG(status) == SIGKILL;
+    }
+
+    /* One line per candidate of an XOR_byte_dec scan */
+    template <class Set>
+    std::string scan_str(const Set& p_found)
+    {
+        std::ostringstream os{};
+
+        for (const auto& e : p_found) {
+            os << std::get<0>(e) << '|' << std::get<1>(e) << '|' << std::get<2>(e).to_Hex() << '|' << std::get<3>(e) << '\n';
+        }
+
+        return os.str();
+    }
+
+    /* One line per report of an XOR_rep_key_dec_corpus run */
+    std::string corpus_str(const std::vector<kim::sec::rep_key_report>& p_reports)
+    {
+        std::ostringstream os{};
+
+        for (const kim::sec::rep_key_report& e : p_reports) {
+            os << e.file << '|' << e.size << '|' << e.guess.key.to_Hex() << '|' << e.guess.score << '|' << e.guess.confidence << '|' << e.error << '\n';
+        }
+
+        return os.str();
+    }
+
+    const std::string g_english{"Now that the party is jumping with the bass kicked in and the Vega's are pumpin', "
+                                "quick to the point, to the point, no faking, cooking MC's like a pound of bacon. "
+                                "Burning 'em, if you ain't quick and nimble, I go crazy when I hear a cymbal "
+                                "and a hi hat with a souped up tempo. I'm on a roll, it's time to go solo. "};
+
+
+    /*** Arena ***/
+
+    /* The file attacks must not rewind the caller's thread arena, which may hold live objects */
+    void test_arena()
+    {
+        TempDir dir{"arena"};
+
+        write_file(dir.file("byte.txt"), "1b37373331363f78151b7f2b783431333d78397828372d363c78373e783a393b3736\n"
+                                         "00112233445566778899AABBCCDDEEFF00112233445566778899AABBCCDDEEFF\n");
+        write_file(dir.file("rep.txt"), rep_key_hex(g_english + g_english, "YELLOW") + "\n");
+
+        guarded("arena_kept_by_file_attacks", [&] {
+            kim::sec::Arena&        arena{kim::sec::Arena::local()};
+            const std::string       text{g_english.substr(0, 200)};
+            const kim::sec::Binary  held{kim::sec::Binary{kim::sec::ascii, text}.view(), arena.resource()};
+
+            const auto              found{kim::sec::XOR_byte_dec<kim::sec::Hex>(kim::sec::FileSource{dir.file("byte.txt")})};
+
+            /* A rewound arena hands the held object's bytes out again */
+            const kim::sec::Binary  after_scan{kim::sec::Binary{kim::sec::ascii, std::string(text.length(), '#')}.view(), arena.resource()};
+
+            check("arena_kept_by_file_attacks", held.to_ASCII() == text, "after XOR_byte_dec(FileSource)");
+            check("arena_kept_by_file_attacks", !found.empty() && std::get<3>(*found.begin()) == "Cooking MC's like a pound of bacon",
+                  "XOR_byte_dec(FileSource) result");
+
+            kim::sec::MemorySink sink{};
+            kim::sec::XOR_rep_key_dec<kim::sec::Hex>(kim::sec::FileSource{dir.file("rep.txt")}, sink);
+
+            const kim::sec::Binary  after_dec{kim::sec::Binary{kim::sec::ascii, std::string(text.length(), '#')}.view(), arena.resource()};
+
+            check("arena_kept_by_file_attacks", held.to_ASCII() == text, "after XOR_rep_key_dec(FileSource, Sink&)");
+            check("arena_kept_by_file_attacks", sink.str() == g_english + g_english, "XOR_rep_key_dec(FileSource, Sink&) result");
+        });
+    }
+
+    /*** Corpus ***/
+
+    /* The corpus cracker recovers every key and reports unreadable entries without stopping */
+    void test_corpus()
+    {
+        TempDir                                         dir{"corpus"};
+        const std::string                               corpus{dir.file("corpus")};
+        const std::vector<std::pair<std::string, std::string>> files{ { "a.txt", "YELLOW" }, { "b.txt", "ORANGE" },
+                                                                      { "sub/c.txt", "BANANA" }, { "sub/deeper/d.txt", "WHITE" } };
+
+        std::filesystem::create_directories(corpus + "/sub/deeper");
+
+        for (const auto& e : files) {
+            write_file(corpus + "/" + e.first, rep_key_hex(g_english, e.second) + "\n");
+        }
+
+        write_file(corpus + "/bad.txt", "not hex at all\n");
+        std::filesystem::create_symlink(corpus + "/missing.txt", corpus + "/dangling.txt");
+
+        /* Permissions do not stop root, so the unreadable directory is only checked for other users */
+        const bool locked{::geteuid() != 0};
+
+        if (locked) {
+            std::filesystem::create_directories(corpus + "/locked");
+            write_file(corpus + "/locked/e.txt", rep_key_hex(g_english, "WHITE") + "\n");
+            std::filesystem::permissions(corpus + "/locked", std::filesystem::perms::none);
+        }
+
+        for (const std::size_t threads : {std::size_t{1}, std::size_t{3}}) {
+            guarded("corpus_keys", [&] {
+                const std::vector<kim::sec::rep_key_report> reports{kim::sec::XOR_rep_key_dec_corpus<kim::sec::Hex>({corpus, dir.file("nowhere")}, threads)};
+                std::map<std::string, const kim::sec::rep_key_report*> by_file{};
+
+                for (const kim::sec::rep_key_report& e : reports) {
+                    by_file[e.file] = &e;
+                }
+
+                check("corpus_sorted", std::is_sorted(reports.begin(), reports.end(), [](const auto& lhs, const auto& rhs) { return lhs.file < rhs.file; }));
+                check("corpus_entries", reports.size() == files.size() + 3 + (locked ? 1 : 0), std::to_string(reports.size()) + " entries");
+
+                for (const auto& e : files) {
+                    const auto found{by_file.find(corpus + "/" + e.first)};
+
+                    check("corpus_keys", found != by_file.end() && found->second->error.empty() && found->second->size == g_english.length()
+                                         && found->second->guess.key.to_ASCII() == e.second,
+                          e.first + (found == by_file.end() ? " missing" : " key " + found->second->guess.key.to_ASCII() + " error " + found->second->error));
+                }
+
+                for (const std::string& e : std::vector<std::string>{corpus + "/bad.txt", corpus + "/dangling.txt", dir.file("nowhere")}) {
+                    const auto found{by_file.find(e)};
+
+                    check("corpus_errors", found != by_file.end() && !found->second->error.empty() && found->second->guess.key.empty(),
+                          e + (found == by_file.end() ? " missing" : " has no error"));
+                }
+
+                if (locked) {
+                    const auto found{by_file.find(corpus + "/locked")};
+
+                    check("corpus_errors", found != by_file.end() && !found->second->error.empty(), "unreadable directory has no error");
+                }
+            });
+        }
+
+        if (locked) {
+            std::filesystem::permissions(corpus + "/locked", std::filesystem::perms::owner_all);
+        }
+    }
+
+
+    /*** Sinks ***/
+
+    /* Writes of every size reach the file in order, through many buffer swaps and on flush, close and destruction */
+    void test_sinks()
+    {
+        TempDir         dir{"sinks"};
+        std::mt19937    gen{40};
+        std::string     data(3 << 20, '\0');
+
+        for (char& e : data) {
+            e = static_cast<char>(gen());
+        }
+
+        guarded("file_sink_large_write", [&] {
+            {
+                kim::sec::FileSink sink{dir.file("large.bin"), 4096};
+
+                for (std::size_t done{}, chunk{1}; done < data.length(); done += chunk, chunk = chunk * 3 % 50021 + 1) {
+                    sink.write(std::string_view{data}.substr(done, chunk));
+                }
+            }
+
+            check("file_sink_large_write", read_file(dir.file("large.bin")) == data, "file differs after destruction");
+
+            /* One write much larger than both buffers */
+            kim::sec::FileSink sink{dir.file("single.bin"), 1000};
+            sink.write(std::string_view{data});
+            sink.close();
+
+            check("file_sink_large_write", read_file(dir.file("single.bin")) == data, "file differs after one large write");
+        });
+
+        guarded("file_sink_flush", [&] {
+            kim::sec::FileSink sink{dir.file("flush.txt")};
+
+            sink.write(std::string_view{"buffered"});
+            check("file_sink_flush", read_file(dir.file("flush.txt")).empty(), "written before a flush");
+
+            sink.flush();
+            check("file_sink_flush", read_file(dir.file("flush.txt")) == "buffered", "not written by flush()");
+
+            sink.write(std::string_view{" then closed"});
+            sink.close();
+            sink.close();
+            check("file_sink_flush", read_file(dir.file("flush.txt")) == "buffered then closed", "not written by close()");
+
+            try {
+                sink.write(std::string_view{"late"});
+                check("file_sink_flush", false, "write after close() did not throw");
+            } catch (const std::runtime_error&) {
+                check("file_sink_flush", true);
+            }
+        });
+
+        guarded("file_sink_errors", [&] {
+            try {
+                kim::sec::FileSink sink{dir.file("nowhere/out.txt")};
+                check("file_sink_errors", false, "created a file in a missing directory");
+            } catch (const std::runtime_error&) {
+                check("file_sink_errors", true);
+            }
+
+            /* Every write to /dev/full fails with ENOSPC on the writer thread */
+            if (std::filesystem::exists("/dev/full")) {
+                kim::sec::FileSink sink{"/dev/full", 16};
+
+                try {
+                    sink.write(std::string_view{data}.substr(0, 100));
+                    sink.flush();
+                    check("file_sink_errors", false, "write error not reported by flush()");
+                } catch (const std::runtime_error&) {
+                    check("file_sink_errors", true);
+                }
+
+                sink.write(std::string_view{"more"});
+
+                try {
+                    sink.close();
+                    check("file_sink_errors", false, "write error not reported by close()");
+                } catch (const std::runtime_error&) {
+                    check("file_sink_errors", true);
+                }
+            }
+        });
+
+        guarded("file_sink_attacks", [&] {
+            write_file(dir.file("rep.txt"), rep_key_hex(g_english + g_english, "YELLOW") + "\n");
+
+            kim::sec::XOR_rep_key_dec<kim::sec::Hex>(kim::sec::FileSource{dir.file("rep.txt")}, dir.file("rep.out")) << "appended";
+
+            check("file_sink_attacks", read_file(dir.file("rep.out")) == g_english + g_english + "appended", "XOR_rep_key_dec(FileSource, file name)");
+        });
+
+        guarded("memory_sink", [&] {
+            kim::sec::MemorySink sink{};
+
+            sink.write(std::string_view{"abc"});
+            sink.write(kim::sec::ByteView{reinterpret_cast<const std::byte*>(data.data()), data.length()});
+            check("memory_sink", sink.str() == "abc" + data);
+
+            sink.clear();
+            sink.write(std::string_view{"d"});
+            check("memory_sink", sink.str() == "d", "clear() kept the old output");
+        });
+
+        guarded("callback_sink", [&] {
+            std::vector<std::string> calls{};
+            kim::sec::CallbackSink   sink{[&](const kim::sec::ByteView p_view) {
+                calls.emplace_back(reinterpret_cast<const char*>(p_view.data()), p_view.length());
+            }};
+
+            sink.write(std::string_view{"one"});
+            sink.write(std::string_view{""});
+            sink.write(std::string_view{data});
+            sink.flush();
+
+            check("callback_sink", calls == std::vector<std::string>{"one", "", data}, std::to_string(calls.size()) + " calls");
+        });
+    }
+
+
+    /*** Sources ***/
+
+    /* Stream buffer over a string that cannot seek, like a pipe */
+    class PipeBuf : public std::streambuf
+    {
+    public:
+        explicit PipeBuf(std::string p_data) : m_data{std::move(p_data)}
+        {
+            setg(m_data.data(), m_data.data(), m_data.data() + m_data.length());
+        }
+
+    private:
+        std::string m_data;
+    };
+
+    /* Every line of a source with the offset after it */
+    std::vector<std::pair<std::string, std::size_t>> read_lines(kim::sec::FileSource& p_Source)
+    {
+        std::vector<std::pair<std::string, std::size_t>> ret{};
+
+        for (std::string_view line{}; p_Source.next_line(line);) {
+            ret.emplace_back(line, p_Source.offset());
+        }
+
+        return ret;
+    }
+
+    /* Mapped files, seekable streams and pipes give the same lines, offsets and joined lines, and resume at any offset */
+    void test_sources()
+    {
+        TempDir dir{"sources"};
+
+        guarded("mapped_file", [&] {
+            write_file(dir.file("empty.txt"), "");
+            write_file(dir.file("data.txt"), "abc\ndef");
+
+            kim::sec::MappedFile empty{dir.file("empty.txt")};
+            kim::sec::MappedFile data{dir.file("data.txt")};
+
+            check("mapped_file", empty.length() == 0 && empty.view().empty() && empty.str().empty(), "empty file");
+            check("mapped_file", data.length() == 7 && data.str() == "abc\ndef" && data.view().length() == 7, "contents");
+
+            kim::sec::MappedFile moved{std::move(data)};
+
+            check("mapped_file", moved.str() == "abc\ndef" && data.length() == 0, "move constructor");
+
+            empty = std::move(moved);
+            check("mapped_file", empty.str() == "abc\ndef" && moved.length() == 0, "move assignment");
+
+            try {
+                kim::sec::MappedFile missing{dir.file("missing.txt")};
+                check("mapped_file", false, "mapped a missing file");
+            } catch (const std::runtime_error&) {
+                check("mapped_file", true);
+            }
+        });
+
+        /* { Contents | Lines | Joined lines } */
+        const std::vector<std::tuple<std::string, std::vector<std::string>, std::string>> cases{
+            { "", {}, "" },
+            { "\n", { "" }, "" },
+            { "abc", { "abc" }, "abc" },
+            { "abc\n", { "abc" }, "abc" },
+            { "ab\ncd\n\nef", { "ab", "cd", "", "ef" }, "abcdef" },
+            { "41\r\n42\r\n", { "41", "42" }, "4142" },
+            { "41\r\n\r\n42\r", { "41", "", "42" }, "4142" },
+            { "a\rb\nc", { "a\rb", "c" }, "a\rbc" } };
+
+        for (std::size_t index{}; index < cases.size(); index++) {
+            const auto& [contents, lines, joined] = cases[index];
+            const std::string name{dir.file("case" + std::to_string(index) + ".txt")};
+            const std::string tag{"case " + std::to_string(index)};
+
+            write_file(name, contents);
+
+            /* Each kind of source, constructed afresh for every read */
+            std::ifstream                   in_File{};
+            std::unique_ptr<PipeBuf>        pipe_buf{};
+            std::unique_ptr<std::istream>   pipe{};
+
+            const std::vector<std::pair<std::string, std::function<kim::sec::FileSource()>>> sources{
+                { "mapped", [&] { return kim::sec::FileSource{name}; } },
+                { "stream", [&] {
+                    in_File = std::ifstream{name, std::ios::binary};
+                    return kim::sec::FileSource{in_File};
+                } },
+                { "pipe", [&] {
+                    pipe.reset();
+                    pipe_buf = std::make_unique<PipeBuf>(contents);
+                    pipe = std::make_unique<std::istream>(pipe_buf.get());
+                    return kim::sec::FileSource{*pipe};
+                } } };
+
+            for (const auto& [kind, open] : sources) {
+                guarded("file_source_lines", [&] {
+                    kim::sec::FileSource        source{open()};
+                    const auto                  read{read_lines(source)};
+                    std::vector<std::string>    got{};
+
+                    for (const auto& e : read) {
+                        got.push_back(e.first);
+                    }
+
+                    check("file_source_mapped", source.mapped() == (kind == "mapped"), tag + " " + kind);
+                    check("file_source_lines", got == lines, tag + " " + kind + " gave " + std::to_string(got.size()) + " lines");
+                    check("file_source_lines", source.offset() == contents.length(), tag + " " + kind + " ends at " + std::to_string(source.offset()));
+                    check("file_source_joined", open().joined_lines() == joined, tag + " " + kind);
+
+                    /* Every line ends at an offset just past its LF (or the end), where the next line starts */
+                    for (std::size_t line{}; line < read.size(); line++) {
+                        kim::sec::FileSource    resumed{open()};
+                        std::string_view        next{};
+
+                        resumed.seek(read[line].second);
+
+                        const bool more{resumed.next_line(next)};
+
+                        check("file_source_seek", resumed.offset() >= read[line].second
+                                                  && more == (line + 1 < read.size()) && (!more || next == read[line + 1].first),
+                              tag + " " + kind + " after line " + std::to_string(line));
+                    }
+
+                    kim::sec::FileSource    rest{open()};
+                    const std::size_t       first_end{read.empty() ? 0 : read.front().second};
+
+                    rest.seek(first_end);
+                    check("file_source_seek", rest.offset() == first_end && rest.rest() == std::string_view{contents}.substr(first_end),
+                          tag + " " + kind + " rest after the first line");
+                });
+            }
+        }
+
+        guarded("file_source_seek", [&] {
+            write_file(dir.file("seek.txt"), "one\ntwo\nthree\n");
+
+            std::ifstream           in_File{dir.file("seek.txt"), std::ios::binary};
+            kim::sec::FileSource    mapped{dir.file("seek.txt")};
+            kim::sec::FileSource    stream{in_File};
+            PipeBuf                 pipe_buf{"one\ntwo\nthree\n"};
+            std::istream            pipe{&pipe_buf};
+
+            for (kim::sec::FileSource* const e : {&mapped, &stream}) {
+                std::string_view line{};
+
+                e->next_line(line);
+                e->next_line(line);
+                e->seek(4);
+                check("file_source_seek", e->offset() == 4 && e->next_line(line) && line == "two", std::string(e->mapped() ? "mapped" : "stream") + " backwards seek");
+            }
+
+            kim::sec::FileSource    source{pipe};
+            std::string_view        line{};
+
+            source.seek(8);
+            check("file_source_seek", source.offset() == 8 && source.next_line(line) && line == "three", "forwards seek in a pipe");
+
+            try {
+                source.seek(4);
+                check("file_source_seek", false, "seeked backwards in a pipe");
+            } catch (const std::runtime_error&) {
+                check("file_source_seek", true);
+            }
+        });
+
+        /* Files written on Windows decode like any other */
+        guarded("file_source_crlf", [&] {
+            const std::string hex{rep_key_hex(g_english, "YELLOW")};
+
+            write_file(dir.file("crlf.txt"), hex.substr(0, 100) + "\r\n" + hex.substr(100) + "\r\n");
+
+            kim::sec::MemorySink sink{};
+            kim::sec::XOR_rep_key_dec<kim::sec::Hex>(kim::sec::FileSource{dir.file("crlf.txt")}, sink);
+
+            check("file_source_crlf", sink.str() == g_english);
+        });
+    }
+
+
+    /*** AES Key Cache ***/
+
+    kim::sec::Binary from_hex(const std::string& p_hex)
+    {
+        return kim::sec::Binary{kim::sec::Hex{p_hex}};
+    }
+
+    std::string to_hex(const kim::sec::Binary& p_bin)
+    {
+        std::ostringstream os{};
+        os << p_bin.to_Hex();
+
+        return os.str();
+    }
+
+    /* Encrypts and decrypts the FIPS-197 example block with a context */
+    bool fips_197(const kim::sec::AesContext& p_context, const std::string& p_ct_hex)
+    {
+        const std::string   pt_hex{"00112233445566778899AABBCCDDEEFF"};
+        kim::sec::Binary    block{from_hex(pt_hex)};
+
+        p_context.enc_block(block.data(), block.data());
+
+        const bool enc_ok{to_hex(block) == p_ct_hex};
+
+        p_context.dec_block(block.data(), block.data());
+
+        return enc_ok && to_hex(block) == pt_hex;
+    }
+
+    /* Hits share the cached schedule, the least recently used key is evicted first, and every key length works */
+    void test_key_cache()
+    {
+        const kim::sec::Binary  key_128{from_hex("000102030405060708090A0B0C0D0E0F")};
+        const kim::sec::Binary  key_192{from_hex("000102030405060708090A0B0C0D0E0F1011121314151617")};
+        const kim::sec::Binary  key_256{from_hex("000102030405060708090A0B0C0D0E0F101112131415161718191A1B1C1D1E1F")};
+
+        guarded("key_cache_lengths", [&] {
+            kim::sec::AesKeyCache cache{};
+
+            for (const auto& [key, ct_hex] : std::vector<std::pair<const kim::sec::Binary*, std::string>>{
+                     { &key_128, "69C4E0D86A7B0430D8CDB78070B4C55A" },
+                     { &key_192, "DDA97CA4864CDFE06EAF70A0EC0D7191" },
+                     { &key_256, "8EA2B7CA516745BFEAFC49904B496089" } }) {
+                const std::shared_ptr<const kim::sec::AesContext> context{cache.get(key->view())};
+
+                check("key_cache_lengths", context->key_length() == key->length() && fips_197(*context, ct_hex),
+                      std::to_string(key->length() * 8) + " bit key");
+                check("key_cache_lengths", cache.get(key->view()) == context && fips_197(*cache.get(key->view()), ct_hex),
+                      std::to_string(key->length() * 8) + " bit key from the cache");
+            }
+
+            check("key_cache_lengths", cache.hits() == 6 && cache.misses() == 3,
+                  std::to_string(cache.hits()) + " hits, " + std::to_string(cache.misses()) + " misses");
+
+            try {
+                cache.get(key_128.view().subview(0, 15));
+                check("key_cache_lengths", false, "cached a 15 byte key");
+            } catch (const std::invalid_argument&) {
+                check("key_cache_lengths", cache.misses() == 3, "a bad key was counted as a miss");
+            }
+        });
+
+        guarded("key_cache_lru", [&] {
+            kim::sec::AesKeyCache cache{2};
+
+            const auto a{cache.get(key_128.view())};
+            const auto b{cache.get(key_192.view())};
+
+            /* a is now the most recently used, so c evicts b */
+            check("key_cache_lru", cache.get(key_128.view()) == a);
+            const auto c{cache.get(key_256.view())};
+
+            check("key_cache_lru", cache.get(key_128.view()) == a && cache.get(key_256.view()) == c, "kept keys were expanded again");
+            check("key_cache_lru", cache.hits() == 3 && cache.misses() == 3);
+
+            /* An evicted context stays usable by its holder, while the cache expands the key afresh (evicting a) */
+            const auto b_again{cache.get(key_192.view())};
+
+            check("key_cache_lru", b_again != b && fips_197(*b, "DDA97CA4864CDFE06EAF70A0EC0D7191"), "evicted key came back");
+            check("key_cache_lru", cache.get(key_256.view()) == c && cache.get(key_128.view()) != a, "wrong key evicted");
+            check("key_cache_lru", cache.hits() == 4 && cache.misses() == 5);
+        });
+
+        guarded("key_cache_capacity", [&] {
+            for (const std::size_t capacity : {std::size_t{0}, std::size_t{1}}) {
+                kim::sec::AesKeyCache   cache{capacity};
+                const auto              a{cache.get(key_128.view())};
+
+                check("key_cache_capacity", cache.get(key_128.view()) == a, "capacity " + std::to_string(capacity) + " missed a repeated key");
+
+                const auto              b{cache.get(key_256.view())};
+
+                check("key_cache_capacity", cache.get(key_128.view()) != a && cache.get(key_128.view()) != b,
+                      "capacity " + std::to_string(capacity) + " kept two keys");
+                check("key_cache_capacity", cache.hits() == 2 && cache.misses() == 3, "capacity " + std::to_string(capacity));
+            }
+        });
+
+        guarded("key_cache_threads", [&] {
+            kim::sec::AesKeyCache       cache{2};
+            kim::sec::ThreadPool        pool{4};
+            std::vector<std::future<bool>> results{};
+
+            for (std::size_t task{}; task < 64; task++) {
+                results.push_back(pool.submit([&, task] {
+                    bool ok{true};
+
+                    for (std::size_t index{}; index < 50; index++) {
+                        switch ((task + index) % 3) {
+                        case 0:
+                            ok = ok && fips_197(*cache.get(key_128.view()), "69C4E0D86A7B0430D8CDB78070B4C55A");
+                            break;
+                        case 1:
+                            ok = ok && fips_197(*cache.get(key_192.view()), "DDA97CA4864CDFE06EAF70A0EC0D7191");
+                            break;
+                        default:
+                            ok = ok && fips_197(*cache.get(key_256.view()), "8EA2B7CA516745BFEAFC49904B496089");
+                            break;
+                        }
+                    }
+
+                    return ok;
+                }));
+            }
+
+            for (std::future<bool>& e : results) {
+                check("key_cache_threads", e.get());
+            }
+
+            check("key_cache_threads", cache.hits() + cache.misses() == 64 * 50);
+        });
+    }
+
+
+    /*** Stats ***/
+
+#if defined(KIM_SEC_STATS)
+    const kim::sec::probe_snapshot& probe_totals(const std::array<kim::sec::probe_snapshot, static_cast<std::size_t>(kim::sec::probe::count)>& p_snapshot,
+                                                 const kim::sec::probe p_probe)
+    {
+        return p_snapshot[static_cast<std::size_t>(p_probe)];
+    }
+#endif
+
+    /* Probes count under KIM_SEC_STATS, summed over every thread that ran them, and record nothing without it */
+    void test_stats()
+    {
+        const kim::sec::Hex hex{std::string(200, 'A')};
+
+#if defined(KIM_SEC_STATS)
+        guarded("stats_counters", [&] {
+            kim::sec::Stats::reset();
+
+            const kim::sec::Binary  bin{hex.to_Bin()};
+            const auto              snapshot{kim::sec::Stats::snapshot()};
+            const auto&             to_Bin{probe_totals(snapshot, kim::sec::probe::Hex_to_Bin)};
+
+            check("stats_counters", to_Bin.calls == 1 && to_Bin.bytes == 200 && to_Bin.cycles > 0,
+                  std::to_string(to_Bin.calls) + " calls, " + std::to_string(to_Bin.bytes) + " bytes");
+
+            /* 100 bytes do not fit inline, so the result is a heap buffer allocated inside the probe */
+            check("stats_counters", to_Bin.bin_allocs >= 1, "no Binary allocation counted");
+            check("stats_counters", probe_totals(snapshot, kim::sec::probe::Hex_to_B64).calls == 0, "an unused probe counted");
+
+            kim::sec::Stats::reset();
+            check("stats_counters", probe_totals(kim::sec::Stats::snapshot(), kim::sec::probe::Hex_to_Bin).calls == 0, "reset() kept the calls");
+        });
+
+        guarded("stats_threads", [&] {
+            constexpr std::size_t tasks{16};
+            constexpr std::size_t per_task{100};
+
+            kim::sec::Stats::reset();
+
+            {
+                kim::sec::ThreadPool            pool{4};
+                std::vector<std::future<void>>  results{};
+
+                for (std::size_t task{}; task < tasks; task++) {
+                    results.push_back(pool.submit([&] {
+                        for (std::size_t index{}; index < per_task; index++) {
+                            static_cast<void>(hex.to_Bin());
+                        }
+                    }));
+                }
+
+                for (std::future<void>& e : results) {
+                    e.get();
+                }
+
+                const auto  snapshot{kim::sec::Stats::snapshot()};
+                const auto& live{probe_totals(snapshot, kim::sec::probe::Hex_to_Bin)};
+
+                check("stats_threads", live.calls == tasks * per_task && live.bytes == tasks * per_task * 200,
+                      "live threads: " + std::to_string(live.calls) + " calls");
+            }
+
+            /* The pool's threads have exited, so their counters are now in the retired totals */
+            const auto  snapshot{kim::sec::Stats::snapshot()};
+            const auto& retired{probe_totals(snapshot, kim::sec::probe::Hex_to_Bin)};
+
+            check("stats_threads", retired.calls == tasks * per_task && retired.bytes == tasks * per_task * 200,
+                  "exited threads: " + std::to_string(retired.calls) + " calls");
+        });
+#else
+        guarded("stats_disabled", [&] {
+            kim::sec::Stats::reset();
+            static_cast<void>(hex.to_Bin());
+            static_cast<void>(hex.to_B64());
+
+            for (const kim::sec::probe_snapshot& e : kim::sec::Stats::snapshot()) {
+                check("stats_disabled", e.calls == 0 && e.bytes == 0 && e.bin_allocs == 0 && e.cycles == 0, std::string(e.name) + " counted");
+            }
+        });
+#endif
+    }
+
+
+    /*** Binary Strings ***/
+
+    /* Bytes of a Binary object as they are (to_ASCII() writes control characters as mnemonics) */
+    std::string raw_str(const kim::sec::Binary& p_bin)
+    {
+        return std::string{reinterpret_cast<const char*>(p_bin.data()), p_bin.length()};
+    }
+
+    /* Whitespace in bit strings is skipped rather than making them ASCII, and the ascii tag always takes characters as bytes */
+    void test_binary_strings()
+    {
+        /* { Input | Bytes, or empty if it must throw } */
+        const std::vector<std::pair<std::string, std::optional<std::string>>> cases{
+            { "01000001", "A" },
+            { "0100 0001", "A" },
+            { "01000001\t01000010\n", "AB" },
+            { " \t01000001\r\n", "A" },
+            { "\n", "" },
+            { " \t\r\n", "" },
+            { "", "" },
+            { "0100000\t", std::nullopt },
+            { "0100000 1 0", std::nullopt },
+            { "01000001 x", "01000001 x" },
+            { "0100000\tx", "0100000\tx" },
+            { "2", "2" } };
+
+        for (const auto& [input, expected] : cases) {
+            guarded("binary_whitespace", [&] {
+                try {
+                    const kim::sec::Binary bin{input};
+                    check("binary_whitespace", expected && raw_str(bin) == *expected,
+                          "\"" + input + "\" gave " + std::to_string(bin.length()) + " bytes");
+                } catch (const std::invalid_argument&) {
+                    check("binary_whitespace", !expected, "\"" + input + "\" threw");
+                }
+
+                /* append() takes bit strings only, with the same whitespace rules */
+                kim::sec::Binary appended{kim::sec::ascii, "#"};
+
+                try {
+                    appended.append(input);
+                    check("binary_whitespace", expected && raw_str(appended) == "#" + *expected, "append(\"" + input + "\")");
+                } catch (const std::invalid_argument&) {
+                    check("binary_whitespace", !expected || *expected == input, "append(\"" + input + "\") threw");
+                }
+            });
+        }
+
+        guarded("binary_ascii_tag", [&] {
+            for (const std::string& e : { std::string("\n"), std::string(" \t"), std::string("01000001"), std::string("0100000\t"), std::string("") }) {
+                const kim::sec::Binary bin{kim::sec::ascii, e};
+
+                check("binary_ascii_tag", bin.length() == e.length() && raw_str(bin) == e, "\"" + e + "\"");
+            }
+        });
+    }
+
+
+    /*** Repeating Key Crack ***/
+
+    /* Key size estimates only compare whole blocks, also when the ciphertext ends exactly on a block boundary */
+    void test_rep_key_crack()
+    {
+        const std::string text{g_english + g_english + g_english + g_english};
+
+        guarded("rep_key_crack_block_multiple", [&] {
+            for (const std::string key : {"YELLOW", "ICE", "VANILLA ICE", "Terminator X"}) {
+                for (const std::size_t target : {std::size_t{800}, std::size_t{1000}, std::size_t{1200}}) {
+                    const std::size_t       length{target / key.length() * key.length()};
+                    std::vector<std::byte>  ct(length);
+
+                    /* Sized exactly, so that a read past the end fails under the sanitizers */
+                    for (std::size_t index{}; index < length; index++) {
+                        ct[index] = static_cast<std::byte>(text[index] ^ key[index % key.length()]);
+                    }
+
+                    const kim::sec::rep_key_guess guess{kim::sec::XOR_rep_key_crack(kim::sec::ByteView{ct.data(), ct.size()})};
+
+                    check("rep_key_crack_block_multiple", raw_str(guess.key) == key,
+                          key + " over " + std::to_string(length) + " bytes gave " + guess.key.to_ASCII());
+                }
+            }
+        });
+
+        guarded("rep_key_crack_short", [&] {
+            for (std::size_t length{}; length <= 100; length++) {
+                std::vector<std::byte> ct(length);
+
+                for (std::size_t index{}; index < length; index++) {
+                    ct[index] = static_cast<std::byte>(text[index] ^ 'K');
+                }
+
+                const kim::sec::rep_key_guess guess{kim::sec::XOR_rep_key_crack(kim::sec::ByteView{ct.data(), ct.size()})};
+
+                check("rep_key_crack_short", length == 0 ? guess.key.empty() : !guess.key.empty() && guess.key.length() <= length,
+                      std::to_string(length) + " bytes gave a " + std::to_string(guess.key.length()) + " byte key");
+            }
+        });
+    }
+
+
+    /*** Attacks ***/
+
+    /* Appending a view copies it even when it views the Binary object itself, and the ECB attack costs one query per byte */
+    void test_attacks()
+    {
+        guarded("binary_append_view", [&] {
+            const std::string   text{g_english.substr(0, 50)};
+            kim::sec::Binary    bin{kim::sec::ascii, text};
+
+            bin += bin.view();
+            bin += bin.view().subview(0, 10);
+            bin += kim::sec::ByteView{};
+
+            check("binary_append_view", bin.to_ASCII() == text + text + text.substr(0, 10), bin.to_ASCII());
+        });
+
+        guarded("ecb_byte_at_a_time", [&] {
+            const kim::sec::Binary secret{kim::sec::ascii, g_english.substr(0, 138)};
+
+            for (const std::size_t prefix_length : {std::size_t{0}, std::size_t{7}, std::size_t{16}, std::size_t{37}}) {
+                const kim::sec::Binary  prefix{kim::sec::ascii, std::string(prefix_length, 'p')};
+                kim::sec::EcbOracle     oracle{secret.view(), prefix.view()};
+
+                check("ecb_byte_at_a_time", kim::sec::ecb_byte_at_a_time(oracle).to_ASCII() == secret.to_ASCII(),
+                      "prefix " + std::to_string(prefix_length));
+
+                /* Two queries for the prefix, two per alignment step, and up to 17 for the secret length */
+                check("ecb_byte_at_a_time", oracle.queries() <= secret.length() + 2 + 2 * 16 + 17,
+                      "prefix " + std::to_string(prefix_length) + " took " + std::to_string(oracle.queries()) + " queries");
+            }
+        });
+    }
+
+
+    /*** Checkpoint ***/
+
+    /* Snapshots round trip, and truncated, corrupt, other-kind and other-input ones are refused */
+    void test_checkpoint_file()
+    {
+        TempDir                 dir{"checkpoint_file"};
+        kim::sec::Checkpoint    ckpt{dir.file("scan.ckpt"), std::chrono::seconds{0}};
+        std::string             payload{};
+        const char              raw[] = "payload\0with a NUL and \xFF bytes";
+        const std::string       saved{raw, sizeof(raw) - 1};
+
+        check("checkpoint_missing", !ckpt.load(kim::sec::checkpoint_kind::byte_scan, "input", payload));
+
+        ckpt.save(kim::sec::checkpoint_kind::byte_scan, "input", saved);
+
+        check("checkpoint_round_trip", ckpt.load(kim::sec::checkpoint_kind::byte_scan, "input", payload) && payload == saved);
+        check("checkpoint_other_kind", !ckpt.load(kim::sec::checkpoint_kind::rep_key_corpus, "input", payload));
+
+        const auto refused = [&](const std::string& p_name, const std::string_view p_identity, const std::string& p_detail) {
+            try {
+                ckpt.load(kim::sec::checkpoint_kind::byte_scan, p_identity, payload);
+                check(p_name, false, p_detail + " was loaded");
+            } catch (const std::runtime_error&) {
+                check(p_name, true);
+            }
+        };
+
+        refused("checkpoint_other_input", "another input", "snapshot of another input");
+
+        std::string contents{};
+        {
+            std::ifstream in{ckpt.file_name(), std::ios::binary};
+            contents.assign(std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{});
+        }
+
+        for (std::size_t length{}; length < contents.length(); length++) {
+            write_file(ckpt.file_name(), std::string_view{contents}.substr(0, length));
+            refused("checkpoint_truncated", "input", "truncated to " + std::to_string(length) + " bytes");
+        }
+
+        for (std::size_t index{}; index < contents.length(); index++) {
+            std::string corrupt{contents};
+
+            corrupt[index] = static_cast<char>(corrupt[index] ^ 0x01);
+            write_file(ckpt.file_name(), corrupt);
+            refused("checkpoint_corrupt", "input", "byte " + std::to_string(index) + " flipped");
+        }
+
+        ckpt.remove();
+        check("checkpoint_remove", !std::filesystem::exists(ckpt.file_name()));
+    }
+
+    /* An XOR byte scan killed partway through resumes to the result of an uninterrupted scan */
+    void test_checkpoint_scan()
+    {
+        TempDir             dir{"checkpoint_scan"};
+        const std::string   input{dir.file("lines.txt")};
+        const std::string   ckpt_name{dir.file("scan.ckpt")};
+        std::mt19937        rng{48};
+        std::string         lines{};
+
+        /* Random lines with English XOR byte encrypted among them */
+        for (std::size_t index{}; index < 20000; index++) {
+            std::string line(30, '\0');
+
+            if (index % 97 == 0) {
+                line = g_english.substr(index % 150, 30);
+
+                for (char& e : line) {
+                    e = static_cast<char>(e ^ static_cast<char>(index % 251));
+                }
+            } else {
+                for (char& e : line) {
+                    e = static_cast<char>(rng());
+                }
+            }
+
+            std::ostringstream os{};
+            os << kim::sec::Binary{kim::sec::ByteView{reinterpret_cast<const std::byte*>(line.data()), line.length()}}.to_Hex();
+            lines += os.str() + '\n';
+        }
+
+        write_file(input, lines);
+
+        guarded("checkpoint_scan_resume", [&] {
+            /* Uninterrupted scans, keeping all candidates and the best 10 (only the checkpointed overload keeps a top k) */
+            kim::sec::Checkpoint    top_ckpt{dir.file("top.ckpt")};
+            const std::string       expected{scan_str(kim::sec::XOR_byte_dec<kim::sec::Hex>(kim::sec::FileSource{input}))};
+            const std::string       expected_top{scan_str(kim::sec::XOR_byte_dec<kim::sec::Hex>(kim::sec::FileSource{input}, top_ckpt, 10))};
+
+            for (const std::size_t top_k : {std::size_t{0}, std::size_t{10}}) {
+                std::filesystem::remove(ckpt_name);
+
+                /* A zero interval saves after every line, so the child is caught mid-scan */
+                const bool killed{kill_partway([&] {
+                    kim::sec::Checkpoint ckpt{ckpt_name, std::chrono::seconds{0}};
+                    kim::sec::XOR_byte_dec<kim::sec::Hex>(kim::sec::FileSource{input}, ckpt, top_k);
+                }, [&] { return std::filesystem::exists(ckpt_name); })};
+
+                kim::sec::Checkpoint    ckpt{ckpt_name, std::chrono::hours{1}};
+                std::string             payload{};
+
+                check("checkpoint_scan_killed", killed, "top_k " + std::to_string(top_k) + " scan finished before it was killed");
+
+                if (!ckpt.load(kim::sec::checkpoint_kind::byte_scan, kim::sec::detail::file_identity(input), payload)) {
+                    check("checkpoint_scan_partway", false, "no snapshot");
+                    continue;
+                }
+
+                std::string_view    rest{payload};
+                const uint64_t      offset{kim::sec::detail::get_u64(rest)};
+
+                check("checkpoint_scan_partway", offset > 0 && offset < lines.length(), "snapshot at offset " + std::to_string(offset));
+
+                const std::string resumed{scan_str(kim::sec::XOR_byte_dec<kim::sec::Hex>(kim::sec::FileSource{input}, ckpt, top_k))};
+
+                check("checkpoint_scan_resume", resumed == (top_k ? expected_top : expected), "top_k " + std::to_string(top_k));
+            }
+
+            /* A finished snapshot resumes to the same result without reading a line */
+            kim::sec::Checkpoint ckpt{ckpt_name, std::chrono::hours{1}};
+
+            check("checkpoint_scan_resume", scan_str(kim::sec::XOR_byte_dec<kim::sec::Hex>(kim::sec::FileSource{input}, ckpt, 10)) == expected_top,
+                  "resumed from a finished snapshot");
+
+            /* Once the input changes the snapshot no longer fits it */
+            write_file(input, lines + "00\n");
+
+            try {
+                kim::sec::XOR_byte_dec<kim::sec::Hex>(kim::sec::FileSource{input}, ckpt, 10);
+                check("checkpoint_scan_changed_input", false, "resumed against a changed file");
+            } catch (const std::runtime_error&) {
+                check("checkpoint_scan_changed_input", true);
+            }
+        });
+    }
+
+    /* A corpus sweep killed partway through resumes to the reports of an uninterrupted sweep */
+    void test_checkpoint_corpus()
+    {
+        TempDir             dir{"checkpoint_corpus"};
+        const std::string   corpus{dir.file("corpus")};
+        const std::string   ckpt_name{dir.file("corpus.ckpt")};
+        const char* const   keys[] = { "YELLOW", "ORANGE", "BANANA", "WHITE" };
+
+        std::filesystem::create_directories(corpus);
+
+        for (std::size_t index{}; index < 300; index++) {
+            write_file(corpus + "/" + std::to_string(1000 + index) + ".txt", rep_key_hex(g_english.substr(index % 40) + g_english, keys[index % 4]) + "\n");
+        }
+
+        guarded("checkpoint_corpus_resume", [&] {
+            const std::string expected{corpus_str(kim::sec::XOR_rep_key_dec_corpus<kim::sec::Hex>({corpus}, 2))};
+
+            const bool killed{kill_partway([&] {
+                kim::sec::Checkpoint ckpt{ckpt_name, std::chrono::seconds{0}};
+                kim::sec::XOR_rep_key_dec_corpus<kim::sec::Hex>({corpus}, 1, &ckpt);
+            }, [&] { return std::filesystem::exists(ckpt_name); })};
+
+            kim::sec::Checkpoint    ckpt{ckpt_name, std::chrono::hours{1}};
+            std::string             payload{};
+
+            check("checkpoint_corpus_killed", killed, "sweep finished before it was killed");
+
+            if (ckpt.load(kim::sec::checkpoint_kind::rep_key_corpus, "", payload)) {
+                std::string_view    rest{payload};
+                const uint64_t      done{kim::sec::detail::get_u64(rest)};
+
+                check("checkpoint_corpus_partway", done > 0 && done < 300, std::to_string(done) + " files in the snapshot");
+            } else {
+                check("checkpoint_corpus_partway", false, "no snapshot");
+            }
+
+            check("checkpoint_corpus_resume", corpus_str(kim::sec::XOR_rep_key_dec_corpus<kim::sec::Hex>({corpus}, 2, &ckpt)) == expected);
+
+            /* A file changed since the snapshot is cracked again instead of being taken from it */
+            const std::string changed{corpus + "/1000.txt"};
+
+            write_file(changed, rep_key_hex(g_english + g_english, "ORANGE") + "\n");
+
+            const std::vector<kim::sec::rep_key_report> reports{kim::sec::XOR_rep_key_dec_corpus<kim::sec::Hex>({corpus}, 2, &ckpt)};
+
+            check("checkpoint_corpus_changed_file", !reports.empty() && reports[0].file == changed && reports[0].guess.key.to_ASCII() == "ORANGE",
+                  reports.empty() ? "no reports" : reports[0].file + " key " + reports[0].guess.key.to_ASCII());
+        });
+    }
+}
+
+int main()
+{
+    test_arena();
+    test_corpus();
+    test_sinks();
+    test_sources();
+    test_key_cache();
+    test_stats();
+    test_binary_strings();
+    test_attacks();
+    test_rep_key_crack();
+    test_checkpoint_file();
+    test_checkpoint_scan();
+    test_checkpoint_corpus();
+
+    std::size_t failed{};
+
+    for (const auto& e : g_stats) {
+        std::cout << e.first << ": " << e.second.cases << " cases";
+
+        if (e.second.failures) {
+            std::cout << ", " << e.second.failures << " FAILED, first at " << e.second.first_failure.substr(0, 400);
+            failed++;
+        }
+
+        std::cout << '\n';
+    }
+
+    std::cout << (failed ? "Some checks failed" : "All checks passed") << std::endl;
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,897 @@
+/*
+ * @brief kim::sec Command-Line Driver
+ * @author Edward Kim
+ *
+ * Usage: kimsec COMMAND [--format hex|b64|raw] [--threads N] [--chunk-size BYTES]
+ *                       [--key TEXT | --key-hex HEX] [--decrypt] [--checkpoint FILE [--checkpoint-interval SECONDS]]
+ *                       [--output FILE] [INPUT...]
+ *
+ * Commands:
+ *   encode         raw bytes in, --format text out
+ *   decode         --format text in, raw bytes out
+ *   xor            --format in and out, XORed with the repeating --key
+ *   crack-byte     one --format ciphertext per line in, "line<TAB>score<TAB>key<TAB>plaintext" out for every line
+ *                  with an ASCII plaintext (control characters are written as mnemonics, e.g. (LF)), and
+ *                  "line<TAB>-<TAB>-<TAB>error" for every line that cannot be decoded
+ *   crack-repkey   one --format ciphertext in, its repeating key XOR plaintext out
+ *   crack-corpus   one --format ciphertext per file, for every file under the INPUT files and directories,
+ *                  "file<TAB>bytes<TAB>key<TAB>confidence[<TAB>error]" out, keys in hex and confidence from 0 to 1
+ *   aes-ecb        raw plaintext in, PKCS#7 padded --format ciphertext out under the 16, 24 or 32 byte --key
+ *                  (--decrypt goes the other way)
+ *   detect-ecb     one --format ciphertext per line in, "line<TAB>repeats<TAB>ciphertext" out for every line
+ *                  with a repeated 16 byte block, and "line<TAB>-<TAB>error" for every line that cannot be decoded
+ *
+ * INPUT and --output default to stdin and stdout ("-"), and --format defaults to hex. Whitespace in text
+ * input is ignored. The input is read --chunk-size bytes at a time (1 MiB by default) and up to --threads
+ * chunks (one per hardware thread by default) are transformed at once, their results written in input order,
+ * so a pipeline never holds more than a few chunks in memory. crack-repkey needs the whole ciphertext to
+ * guess the key size and runs on one thread, while crack-corpus runs one file per thread, largest first.
+ * Only crack-corpus takes more than one INPUT. With --checkpoint it saves the reports of the files done so far
+ * every --checkpoint-interval seconds (60 by default); run it again with the same checkpoint after it is killed
+ * and it only cracks the files it had not finished. The checkpoint is deleted once the report is written.
+ * Throughput is reported on stderr.
+ */
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <chrono>
+#include <memory>
+#include <variant>
+#include <optional>
+#include <functional>
+#include <algorithm>
+#include <iterator>
+#include <thread>
+#include <type_traits>
+#include <filesystem>
+#include <iomanip>
+
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+
+#include "kim_sec.hpp"
+
+namespace
+{
+    enum class format { hex, b64, raw };
+
+    struct cli_options
+    {
+        std::string                 command{};
+        format                      fmt{format::hex};
+        std::size_t                 threads{};
+        std::size_t                 chunk_size{1 << 20};
+        kim::sec::Binary            key{};
+        bool                        decrypt{};
+        std::string                 input{"-"};
+        std::vector<std::string>    inputs{};
+        std::string                 output{"-"};
+        std::string                 checkpoint{};
+        double                      checkpoint_interval{60};
+        bool                        help{};
+    };
+
+    /*
+     * A piece of the input handed to one task
+     * - Views the memory mapped input, or a copy shared with the task when the input is streamed or filtered
+     * - offset is the position of the first character in the (whitespace-free) input, or the number of the
+     *   first line (from 1) when reading lines
+     */
+    struct chunk
+    {
+        std::shared_ptr<const std::string>  owner{};
+        std::string_view                    data{};
+        std::size_t                         offset{};
+        bool                                last{};
+    };
+
+    /* Everything a task can produce, written as is by write_output() */
+    using output = std::variant<std::string, kim::sec::Binary, kim::sec::Hex, kim::sec::Base64>;
+
+    void usage(std::ostream& os)
+    {
+        os << "Usage: kimsec encode|decode|xor|crack-byte|crack-repkey|crack-corpus|aes-ecb|detect-ecb\n"
+              "              [--format hex|b64|raw] [--threads N] [--chunk-size BYTES]\n"
+              "              [--key TEXT | --key-hex HEX] [--decrypt] [--checkpoint FILE [--checkpoint-interval SECONDS]]\n"
+              "              [--output FILE] [INPUT...]\n";
+    }
+
+    bool is_space(const char p_chr)
+    {
+        return p_chr == ' ' || p_chr == '\t' || p_chr == '\n' || p_chr == '\r';
+    }
+
+    kim::sec::ByteView bytes(const std::string_view p_str)
+    {
+        return kim::sec::ByteView{reinterpret_cast<const std::byte*>(p_str.data()), p_str.length()};
+    }
+
+    /*
+     * Splits a regular file (memory mapped) or a stream (read through a buffer) into chunks
+     * - bytes: chunk-size bytes, a multiple of the alignment except for the last chunk
+     * - text:  about chunk-size characters with whitespace removed, a multiple of the alignment except for the last chunk
+     * - lines: about chunk-size characters of whole lines
+     * - Always yields at least one chunk, the last one flagged, so that empty input still gets e.g. its padding block
+     */
+    class ChunkReader
+    {
+    public:
+        enum class mode { bytes, text, lines };
+
+        ChunkReader(const std::string& p_name, const mode p_mode, const std::size_t p_chunk_size, const std::size_t p_align)
+            : m_mode{p_mode}, m_align{p_align}, m_chunk_size{std::max(p_align, p_chunk_size / p_align * p_align)}
+        {
+            /* Regular files are mapped, anything else (stdin, pipes, devices) is streamed like FileSource does */
+            if (p_name == "-") {
+                m_stream = &std::cin;
+            } else if (std::filesystem::is_regular_file(p_name)) {
+                m_file.emplace(p_name);
+            } else {
+                m_own = std::make_unique<std::ifstream>(p_name, std::ios::binary);
+
+                if (!*m_own) {
+                    throw std::runtime_error("Cannot open " + p_name);
+                }
+
+                m_stream = m_own.get();
+            }
+        }
+
+        /* Reads the next chunk, returning false once the last chunk has been read */
+        bool next(chunk& p_chunk)
+        {
+            if (m_done) {
+                return false;
+            }
+
+            switch (m_mode) {
+                case mode::bytes:
+                    next_bytes(p_chunk);
+                    break;
+                case mode::text:
+                    next_text(p_chunk);
+                    break;
+                case mode::lines:
+                    next_lines(p_chunk);
+                    break;
+            }
+
+            m_done = p_chunk.last;
+
+            return true;
+        }
+
+        /* Returns the number of input bytes read so far */
+        std::size_t consumed() const
+        {
+            return m_consumed;
+        }
+
+    private:
+        /* Reads up to p_size bytes, the view lasting until the next read (or for ever when mapped) */
+        std::string_view read(const std::size_t p_size)
+        {
+            std::string_view ret{};
+
+            if (m_file) {
+                ret = m_file->str().substr(m_pos, p_size);
+                m_pos += ret.length();
+            } else {
+                m_buffer.resize(p_size);
+                m_stream->read(m_buffer.data(), static_cast<std::streamsize>(p_size));
+                ret = std::string_view{m_buffer.data(), static_cast<std::size_t>(m_stream->gcount())};
+            }
+
+            m_consumed += ret.length();
+
+            return ret;
+        }
+
+        bool eof()
+        {
+            return m_file ? m_pos == m_file->length() : m_stream->peek() == std::char_traits<char>::eof();
+        }
+
+        /* Skips whitespace, so that text ending in a newline is at its end once its last digit has been read */
+        void skip_space()
+        {
+            if (m_file) {
+                for (; m_pos < m_file->length() && is_space(m_file->str()[m_pos]); m_pos++) {
+                    m_consumed++;
+                }
+            } else {
+                for (int chr{m_stream->peek()}; chr != std::char_traits<char>::eof() && is_space(static_cast<char>(chr)); chr = m_stream->peek()) {
+                    m_stream->get();
+                    m_consumed++;
+                }
+            }
+        }
+
+        void next_bytes(chunk& p_chunk)
+        {
+            p_chunk.offset = m_offset;
+            p_chunk.data = read(m_chunk_size);
+            p_chunk.owner.reset();
+
+            if (!m_file) {
+                p_chunk.owner = std::make_shared<const std::string>(p_chunk.data);
+                p_chunk.data = *p_chunk.owner;
+            }
+
+            p_chunk.last = eof();
+            m_offset += p_chunk.data.length();
+        }
+
+        void next_text(chunk& p_chunk)
+        {
+            std::string text{std::move(m_carry)};
+
+            m_carry.clear();
+
+            while (text.length() < m_chunk_size && !eof()) {
+                const std::string_view raw{read(m_chunk_size)};
+
+                std::copy_if(raw.begin(), raw.end(), std::back_inserter(text), [](const char e) { return !is_space(e); });
+            }
+
+            /* Otherwise a trailing newline would hold back the last flag for an empty chunk after the real last one */
+            skip_space();
+            p_chunk.last = eof();
+
+            if (!p_chunk.last) {
+                m_carry.assign(text, text.length() / m_align * m_align, std::string::npos);
+                text.resize(text.length() / m_align * m_align);
+            }
+
+            p_chunk.offset = m_offset;
+            p_chunk.owner = std::make_shared<const std::string>(std::move(text));
+            p_chunk.data = *p_chunk.owner;
+            m_offset += p_chunk.data.length();
+        }
+
+        void next_lines(chunk& p_chunk)
+        {
+            if (m_file) {
+                const std::string_view  rest{m_file->str().substr(m_pos)};
+                std::size_t             end{rest.length()};
+
+                /* Cut after the last LF within the chunk, or after the first one past it for a very long line */
+                if (rest.length() > m_chunk_size) {
+                    end = rest.rfind('\n', m_chunk_size - 1);
+                    end = end == std::string_view::npos ? rest.find('\n', m_chunk_size) : end;
+                    end = end == std::string_view::npos ? rest.length() : end + 1;
+                }
+
+                p_chunk.data = read(end);
+                p_chunk.owner.reset();
+            } else {
+                std::string text{std::move(m_carry)};
+
+                m_carry.clear();
+
+                do {
+                    text += read(m_chunk_size);
+                } while (text.find('\n') == std::string::npos && !eof());
+
+                if (!eof()) {
+                    const std::size_t end{text.rfind('\n') + 1};
+
+                    m_carry.assign(text, end, std::string::npos);
+                    text.resize(end);
+                }
+
+                p_chunk.owner = std::make_shared<const std::string>(std::move(text));
+                p_chunk.data = *p_chunk.owner;
+            }
+
+            p_chunk.last = eof() && m_carry.empty();
+            p_chunk.offset = m_offset + 1;
+            m_offset += static_cast<std::size_t>(std::count(p_chunk.data.begin(), p_chunk.data.end(), '\n'));
+        }
+
+        mode                                m_mode;
+        std::size_t                         m_align;
+        std::size_t                         m_chunk_size;
+        std::optional<kim::sec::MappedFile> m_file{};
+        std::unique_ptr<std::ifstream>      m_own{};
+        std::istream*                       m_stream{};
+        std::size_t                         m_pos{};
+        std::string                         m_buffer{};
+        std::string                         m_carry{};
+        std::size_t                         m_offset{};
+        std::size_t                         m_consumed{};
+        bool                                m_done{};
+    };
+
+    /* Writes a task's result, returning the number of bytes written */
+    std::size_t write_output(std::ostream& p_out, const output& p_output)
+    {
+        return std::visit([&](const auto& e) -> std::size_t {
+            using type = std::decay_t<decltype(e)>;
+
+            if constexpr (std::is_same_v<type, std::string>) {
+                p_out.write(e.data(), static_cast<std::streamsize>(e.length()));
+            } else if constexpr (std::is_same_v<type, kim::sec::Binary>) {
+                p_out.write(reinterpret_cast<const char*>(e.data()), static_cast<std::streamsize>(e.length()));
+            } else {
+                p_out << e;
+            }
+
+            return e.length();
+        }, p_output);
+    }
+
+    /*
+     * Transforms every chunk of the input and writes the results in input order
+     * - With more than one thread, up to two chunks per thread are in flight on a kim::sec::ThreadPool
+     * - The pool is joined before returning (or rethrowing a task's exception), so the tasks never outlive p_transform
+     *
+     * Returns the number of bytes written
+     */
+    std::size_t run_chunks(ChunkReader& p_reader, std::ostream& p_out, const std::size_t p_threads,
+                           const std::function<output(const chunk&)>& p_transform)
+    {
+        std::size_t ret{};
+        chunk       next{};
+
+        if (p_threads <= 1) {
+            while (p_reader.next(next)) {
+                ret += write_output(p_out, p_transform(next));
+            }
+
+            return ret;
+        }
+
+        kim::sec::ThreadPool            pool{p_threads};
+        std::deque<std::future<output>> pending{};
+
+        while (p_reader.next(next)) {
+            pending.push_back(pool.submit([next, &p_transform] { return p_transform(next); }));
+
+            if (pending.size() >= 2 * p_threads) {
+                ret += write_output(p_out, pending.front().get());
+                pending.pop_front();
+            }
+        }
+
+        for (; !pending.empty(); pending.pop_front()) {
+            ret += write_output(p_out, pending.front().get());
+        }
+
+        return ret;
+    }
+
+    /* Decodes text in the given format into a buffer from the resource */
+    kim::sec::Binary decode(const std::string_view p_text, const format p_fmt, std::pmr::memory_resource* p_resource)
+    {
+        switch (p_fmt) {
+            case format::hex:
+                return kim::sec::Hex{p_text, p_resource}.to_Bin(p_resource);
+            case format::b64:
+                return kim::sec::Base64{p_text, p_resource}.to_Bin(p_resource);
+            default:
+                return kim::sec::Binary{bytes(p_text), p_resource};
+        }
+    }
+
+    /* Encodes bytes in the given format (Base64 chunks other than the last must be a multiple of 3 bytes long) */
+    output encode(const kim::sec::ByteView p_view, const format p_fmt)
+    {
+        switch (p_fmt) {
+            case format::hex:
+                return kim::sec::Binary{p_view}.to_Hex();
+            case format::b64: {
+                kim::sec::Base64 ret{};
+                ret.append(p_view);
+                return ret;
+            }
+            default:
+                return kim::sec::Binary{p_view};
+        }
+    }
+
+    /* Characters of text per decoded group of bytes */
+    std::size_t text_align(const format p_fmt)
+    {
+        return p_fmt == format::hex ? 2 : p_fmt == format::b64 ? 4 : 1;
+    }
+
+    /* Number of bytes decoded from the characters before a text offset */
+    std::size_t byte_offset(const std::size_t p_offset, const format p_fmt)
+    {
+        return p_fmt == format::hex ? p_offset / 2 : p_fmt == format::b64 ? p_offset / 4 * 3 : p_offset;
+    }
+
+    ChunkReader::mode text_mode(const format p_fmt)
+    {
+        return p_fmt == format::raw ? ChunkReader::mode::bytes : ChunkReader::mode::text;
+    }
+
+    /* Plaintext for one output line, with LF written as a mnemonic like the other control characters */
+    std::string escape_line(const kim::sec::ByteView p_view)
+    {
+        const std::string   ascii{kim::sec::format_ascii(p_view)};
+        std::string         ret{};
+
+        ret.reserve(ascii.length());
+
+        for (const char e : ascii) {
+            ret += e == '\n' ? std::string_view{"(LF)"} : std::string_view{&e, 1};
+        }
+
+        return ret;
+    }
+
+    /* Calls p_func with the number and text of every non-empty line of a lines chunk */
+    template <class Function>
+    void for_each_line(const chunk& p_chunk, Function&& p_func)
+    {
+        std::size_t number{p_chunk.offset};
+
+        for (std::size_t pos{}; pos < p_chunk.data.length(); number++) {
+            const std::size_t   end{std::min(p_chunk.data.find('\n', pos), p_chunk.data.length())};
+            std::string_view    line{p_chunk.data.substr(pos, end - pos)};
+
+            if (!line.empty() && line.back() == '\r') {
+                line.remove_suffix(1);
+            }
+
+            if (!line.empty()) {
+                p_func(number, line);
+            }
+
+            pos = end + 1;
+        }
+    }
+
+    std::size_t run_encode(const cli_options& p_opts, ChunkReader& p_reader, std::ostream& p_out)
+    {
+        return run_chunks(p_reader, p_out, p_opts.threads, [&](const chunk& p_chunk) {
+            return encode(bytes(p_chunk.data), p_opts.fmt);
+        });
+    }
+
+    std::size_t run_decode(const cli_options& p_opts, ChunkReader& p_reader, std::ostream& p_out)
+    {
+        return run_chunks(p_reader, p_out, p_opts.threads, [&](const chunk& p_chunk) -> output {
+            kim::sec::Arena& arena{kim::sec::Arena::local()};
+            output           ret{kim::sec::Binary{decode(p_chunk.data, p_opts.fmt, arena.resource()).view()}};
+
+            arena.reset();
+
+            return ret;
+        });
+    }
+
+    std::size_t run_xor(const cli_options& p_opts, ChunkReader& p_reader, std::ostream& p_out)
+    {
+        return run_chunks(p_reader, p_out, p_opts.threads, [&](const chunk& p_chunk) -> output {
+            kim::sec::Arena&    arena{kim::sec::Arena::local()};
+            output              ret{};
+
+            {
+                kim::sec::Binary    data{decode(p_chunk.data, p_opts.fmt, arena.resource())};
+                const std::size_t   key_length{p_opts.key.length()};
+
+                for (std::size_t index{}, key_index{byte_offset(p_chunk.offset, p_opts.fmt) % key_length}; index < data.length(); index++) {
+                    data[index] ^= p_opts.key[key_index];
+                    key_index = key_index + 1 == key_length ? 0 : key_index + 1;
+                }
+
+                ret = encode(data.view(), p_opts.fmt);
+            }
+
+            arena.reset();
+
+            return ret;
+        });
+    }
+
+    std::size_t run_aes_ecb(const cli_options& p_opts, ChunkReader& p_reader, std::ostream& p_out)
+    {
+        const kim::sec::AesContext context{p_opts.key.view()};
+
+        return run_chunks(p_reader, p_out, p_opts.threads, [&](const chunk& p_chunk) -> output {
+            kim::sec::Arena&    arena{kim::sec::Arena::local()};
+            output              ret{};
+
+            if (p_opts.decrypt) {
+                {
+                    kim::sec::Binary pt{kim::sec::aes_ecb_dec(decode(p_chunk.data, p_opts.fmt, arena.resource()).view(), context)};
+
+                    if (p_chunk.last) {
+                        pt.pkcs7_unpad();
+                    }
+
+                    ret = std::move(pt);
+                }
+            } else {
+                kim::sec::Binary pt{bytes(p_chunk.data), arena.resource()};
+
+                if (p_chunk.last) {
+                    pt.pkcs7_pad();
+                }
+
+                ret = encode(kim::sec::aes_ecb_enc(pt.view(), context).view(), p_opts.fmt);
+            }
+
+            arena.reset();
+
+            return ret;
+        });
+    }
+
+    std::size_t run_crack_byte(const cli_options& p_opts, ChunkReader& p_reader, std::ostream& p_out)
+    {
+        return run_chunks(p_reader, p_out, p_opts.threads, [&](const chunk& p_chunk) -> output {
+            kim::sec::Arena&    arena{kim::sec::Arena::local()};
+            std::string         ret{};
+
+            {
+                /* Decode every line into one buffer so the whole chunk is scored in one batch */
+                kim::sec::Binary                cts{arena.resource()};
+                std::pmr::vector<std::size_t>   offsets(1, 0, arena.resource());
+                std::pmr::vector<std::size_t>   numbers{arena.resource()};
+                std::vector<std::string>        errors{};
+
+                /* A line that cannot be decoded gets an empty ciphertext and its error, the others are still cracked */
+                for_each_line(p_chunk, [&](const std::size_t p_number, const std::string_view p_line) {
+                    std::string error{};
+
+                    try {
+                        cts += decode(p_line, p_opts.fmt, arena.resource());
+                    } catch (const std::invalid_argument& e) {
+                        error = e.what();
+                    }
+
+                    offsets.push_back(cts.length());
+                    numbers.push_back(p_number);
+                    errors.push_back(std::move(error));
+                });
+
+                const kim::sec::BatchView   batch{cts.view(), offsets.data(), numbers.size()};
+                const auto                  keys{kim::sec::XOR_byte_dec_batch(batch)};
+
+                for (std::size_t index{}; index < keys.size(); index++) {
+                    if (!errors[index].empty()) {
+                        ret += std::to_string(numbers[index]) + "\t-\t-\t" + errors[index] + '\n';
+                        continue;
+                    }
+
+                    if (keys[index].first == 0) {
+                        continue;
+                    }
+
+                    const kim::sec::Binary  key{keys[index].second};
+                    std::ostringstream      line{};
+
+                    line << numbers[index] << '\t' << keys[index].first << '\t' << key.to_Hex() << '\t'
+                         << escape_line(kim::sec::XOR(batch[index], key.view()).view()) << '\n';
+                    ret += line.str();
+                }
+            }
+
+            arena.reset();
+
+            return ret;
+        });
+    }
+
+    std::size_t run_detect_ecb(const cli_options& p_opts, ChunkReader& p_reader, std::ostream& p_out)
+    {
+        return run_chunks(p_reader, p_out, p_opts.threads, [&](const chunk& p_chunk) -> output {
+            kim::sec::Arena&    arena{kim::sec::Arena::local()};
+            std::string         ret{};
+
+            for_each_line(p_chunk, [&](const std::size_t p_number, const std::string_view p_line) {
+                std::size_t repeats{};
+
+                try {
+                    const kim::sec::Binary ct{decode(p_line, p_opts.fmt, arena.resource())};
+                    repeats = kim::sec::aes_ecb_repeats(ct.view(), arena.resource());
+                } catch (const std::invalid_argument& e) {
+                    ret += std::to_string(p_number) + "\t-\t" + e.what() + '\n';
+                }
+
+                arena.reset();
+
+                if (repeats) {
+                    ret += std::to_string(p_number) + '\t' + std::to_string(repeats) + '\t';
+                    ret += p_line;
+                    ret += '\n';
+                }
+            });
+
+            return ret;
+        });
+    }
+
+    std::size_t run_crack_repkey(const cli_options& p_opts, std::size_t& p_consumed, std::ostream& p_out)
+    {
+        std::size_t             ret{};
+        std::istringstream      in{};
+        kim::sec::CallbackSink  sink{[&](const kim::sec::ByteView p_view) {
+            p_out.write(reinterpret_cast<const char*>(p_view.data()), static_cast<std::streamsize>(p_view.length()));
+            ret += p_view.length();
+        }};
+
+        /* Stdin is read up front so that its size is known for the throughput report */
+        if (p_opts.input == "-") {
+            in.str(std::string{std::istreambuf_iterator<char>{std::cin}, std::istreambuf_iterator<char>{}});
+            p_consumed = in.str().length();
+        } else if (std::filesystem::is_regular_file(p_opts.input)) {
+            p_consumed = std::filesystem::file_size(p_opts.input);
+        }
+
+        kim::sec::FileSource source{p_opts.input == "-" ? kim::sec::FileSource{in} : kim::sec::FileSource{p_opts.input}};
+
+        if (p_opts.fmt == format::hex) {
+            kim::sec::XOR_rep_key_dec<kim::sec::Hex>(std::move(source), sink);
+        } else {
+            kim::sec::XOR_rep_key_dec<kim::sec::Base64>(std::move(source), sink);
+        }
+
+        sink.flush();
+
+        return ret;
+    }
+
+    std::size_t run_crack_corpus(const cli_options& p_opts, std::size_t& p_consumed, std::ostream& p_out)
+    {
+        if (p_opts.inputs.empty()) {
+            throw std::invalid_argument("crack-corpus needs files or directories");
+        }
+
+        std::optional<kim::sec::Checkpoint> checkpoint{};
+
+        if (!p_opts.checkpoint.empty()) {
+            checkpoint.emplace(p_opts.checkpoint, std::chrono::duration<double>{p_opts.checkpoint_interval});
+        }
+
+        kim::sec::Checkpoint* const checkpoint_ptr{checkpoint ? &*checkpoint : nullptr};
+
+        const std::vector<kim::sec::rep_key_report> reports{
+            p_opts.fmt == format::hex ? kim::sec::XOR_rep_key_dec_corpus<kim::sec::Hex>(p_opts.inputs, p_opts.threads, checkpoint_ptr)
+                                      : kim::sec::XOR_rep_key_dec_corpus<kim::sec::Base64>(p_opts.inputs, p_opts.threads, checkpoint_ptr)};
+        std::size_t ret{};
+
+        for (const kim::sec::rep_key_report& e : reports) {
+            std::ostringstream      line{};
+            std::error_code         error{};
+            const std::uintmax_t    size{std::filesystem::file_size(e.file, error)};
+
+            p_consumed += error ? 0 : static_cast<std::size_t>(size);
+
+            line << e.file << '\t' << e.size << '\t';
+
+            if (e.error.empty()) {
+                line << e.guess.key.to_Hex() << '\t' << std::fixed << std::setprecision(4) << e.guess.confidence << '\n';
+            } else {
+                line << "-\t-\t" << e.error << '\n';
+            }
+
+            ret += write_output(p_out, line.str());
+        }
+
+        p_out.flush();
+
+        if (checkpoint && p_out) {
+            checkpoint->remove();
+        }
+
+        return ret;
+    }
+
+    /* Parses a count of at least p_min, throwing std::invalid_argument for anything else (stoull takes "-1" as its negation) */
+    std::size_t parse_count(const std::string& p_option, const std::string& p_value, const std::size_t p_min)
+    {
+        std::size_t ret{};
+        std::size_t end{};
+
+        try {
+            ret = p_value.find_first_not_of("0123456789") == std::string::npos ? std::stoull(p_value, &end) : 0;
+        } catch (const std::out_of_range&) {
+            end = 0;
+        }
+
+        if (p_value.empty() || end != p_value.length() || ret < p_min) {
+            throw std::invalid_argument(p_option + " needs a whole number of at least " + std::to_string(p_min) + ", not " + p_value);
+        }
+
+        return ret;
+    }
+
+    /* Parses the options, throwing std::invalid_argument on a bad one */
+    cli_options parse(const int argc, char* argv[])
+    {
+        cli_options ret{};
+
+        for (int index{1}; index < argc; index++) {
+            const std::string arg{argv[index]};
+
+            const auto value = [&]() -> std::string {
+                if (index + 1 >= argc) {
+                    throw std::invalid_argument("Missing value for " + arg);
+                }
+
+                return argv[++index];
+            };
+
+            if (arg == "-h" || arg == "--help") {
+                ret.help = true;
+            } else if (arg == "--format") {
+                const std::string fmt{value()};
+
+                if (fmt == "hex") {
+                    ret.fmt = format::hex;
+                } else if (fmt == "b64") {
+                    ret.fmt = format::b64;
+                } else if (fmt == "raw") {
+                    ret.fmt = format::raw;
+                } else {
+                    throw std::invalid_argument("Unknown format " + fmt);
+                }
+            } else if (arg == "--threads") {
+                ret.threads = parse_count(arg, value(), 1);
+            } else if (arg == "--chunk-size") {
+                ret.chunk_size = std::max<std::size_t>(parse_count(arg, value(), 0), 1);
+            } else if (arg == "--key") {
+                ret.key = kim::sec::Binary{kim::sec::ascii, value()};
+            } else if (arg == "--key-hex") {
+                ret.key = kim::sec::Binary{kim::sec::Hex{value()}};
+            } else if (arg == "--checkpoint") {
+                ret.checkpoint = value();
+            } else if (arg == "--checkpoint-interval") {
+                ret.checkpoint_interval = std::stod(value());
+            } else if (arg == "--decrypt") {
+                ret.decrypt = true;
+            } else if (arg == "-o" || arg == "--output") {
+                ret.output = value();
+            } else if (arg.length() > 1 && arg[0] == '-') {
+                throw std::invalid_argument("Unknown option " + arg);
+            } else if (ret.command.empty()) {
+                ret.command = arg;
+            } else {
+                ret.inputs.push_back(arg);
+            }
+        }
+
+        if (ret.inputs.size() > 1 && ret.command != "crack-corpus") {
+            throw std::invalid_argument("Unexpected argument " + ret.inputs[1]);
+        }
+
+        if (!ret.inputs.empty()) {
+            ret.input = ret.inputs.front();
+        }
+
+        if (ret.threads == 0) {
+            ret.threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+        }
+
+        return ret;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    using clock = std::chrono::steady_clock;
+
+    std::ios::sync_with_stdio(false);
+
+    try {
+        const cli_options       opts{parse(argc, argv)};
+
+        if (opts.help) {
+            usage(std::cout);
+            return 0;
+        }
+
+        const clock::time_point start{clock::now()};
+        std::ofstream           out_File{};
+        std::size_t             consumed{};
+        std::size_t             written{};
+        bool                    text_out{opts.fmt != format::raw};
+
+        if (opts.output != "-") {
+            out_File.open(opts.output, std::ios::binary);
+
+            if (!out_File) {
+                throw std::runtime_error("Cannot open " + opts.output);
+            }
+        }
+
+        std::ostream& out{opts.output != "-" ? static_cast<std::ostream&>(out_File) : std::cout};
+
+        const auto reader = [&](const ChunkReader::mode p_mode, const std::size_t p_align) {
+            return ChunkReader{opts.input, p_mode, opts.chunk_size, p_align};
+        };
+
+        const auto need_key = [&] {
+            if (opts.key.empty()) {
+                throw std::invalid_argument(opts.command + " needs --key or --key-hex");
+            }
+        };
+
+        const auto need_text = [&] {
+            if (opts.fmt == format::raw) {
+                throw std::invalid_argument(opts.command + " needs --format hex or b64");
+            }
+        };
+
+        std::optional<ChunkReader> in{};
+
+        if (opts.command == "encode") {
+            in.emplace(reader(ChunkReader::mode::bytes, opts.fmt == format::b64 ? 3 : 1));
+            written = run_encode(opts, *in, out);
+        } else if (opts.command == "decode") {
+            in.emplace(reader(text_mode(opts.fmt), text_align(opts.fmt)));
+            written = run_decode(opts, *in, out);
+            text_out = false;
+        } else if (opts.command == "xor") {
+            need_key();
+            in.emplace(reader(text_mode(opts.fmt), text_align(opts.fmt)));
+            written = run_xor(opts, *in, out);
+        } else if (opts.command == "aes-ecb") {
+            need_key();
+
+            if (opts.decrypt) {
+                in.emplace(reader(text_mode(opts.fmt), text_align(opts.fmt) * 16));
+                text_out = false;
+            } else {
+                in.emplace(reader(ChunkReader::mode::bytes, opts.fmt == format::b64 ? 48 : 16));
+            }
+
+            written = run_aes_ecb(opts, *in, out);
+        } else if (opts.command == "crack-byte") {
+            need_text();
+            in.emplace(reader(ChunkReader::mode::lines, 1));
+            written = run_crack_byte(opts, *in, out);
+            text_out = false;
+        } else if (opts.command == "detect-ecb") {
+            need_text();
+            in.emplace(reader(ChunkReader::mode::lines, 1));
+            written = run_detect_ecb(opts, *in, out);
+            text_out = false;
+        } else if (opts.command == "crack-repkey") {
+            need_text();
+            written = run_crack_repkey(opts, consumed, out);
+            text_out = false;
+        } else if (opts.command == "crack-corpus") {
+            need_text();
+            written = run_crack_corpus(opts, consumed, out);
+            text_out = false;
+        } else {
+            usage(std::cerr);
+            return 1;
+        }
+
+        /* Encoded output ends with a LF like any other text */
+        if (text_out && written) {
+            out << '\n';
+        }
+
+        out.flush();
+
+        if (!out) {
+            throw std::runtime_error("Cannot write " + opts.output);
+        }
+
+        const double seconds{std::chrono::duration<double>(clock::now() - start).count()};
+
+        consumed = in ? in->consumed() : consumed;
+
+        std::cerr << "kimsec " << opts.command << ": " << consumed << " B in, " << written << " B out, "
+                  << seconds << " s, " << (consumed / 1e6) / std::max(seconds, 1e-9) << " MB/s ("
+                  << opts.threads << (opts.threads == 1 ? " thread" : " threads") << ")" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "kimsec: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
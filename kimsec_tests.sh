@@ -0,0 +1,137 @@
+#!/bin/sh
+#
+# @brief kimsec Command-Line Tests
+# @author Edward Kim
+#
+# Usage: kimsec_tests.sh PATH/TO/kimsec
+#
+# Encrypts and decrypts with aes-ecb, and encodes and decodes, for every format, thread count and chunk size,
+# reading both mapped files and stdin. The chunk sizes include exact multiples of the ciphertext text, with and
+# without the trailing newline kimsec writes, where the last chunk is easiest to misjudge.
+# Then checks xor, crack-byte, crack-repkey, crack-corpus and detect-ecb against known answers, including lines
+# that cannot be decoded (reported without stopping the batch), and that bad --threads values are rejected.
+# Prints the failing cases and exits with 1 if any case does not give the expected output.
+
+KIMSEC=${1:?"Usage: $0 PATH/TO/kimsec"}
+KEY="YELLOW SUBMARINE"
+TMP=$(mktemp -d)
+FAILED=0
+CASES=0
+
+trap 'rm -rf "$TMP"' EXIT
+
+fail()
+{
+    echo "FAILED: $*"
+    FAILED=$((FAILED + 1))
+}
+
+# Compares the expected and actual output files of a case
+expect()
+{
+    CASES=$((CASES + 1))
+    cmp -s "$2" "$3" || fail "$1: got $(head -c 300 "$3")"
+}
+
+for SIZE in 0 1 15 16 17 48 100 1000; do
+    head -c "$SIZE" /dev/urandom > "$TMP/pt"
+
+    for FORMAT in hex b64 raw; do
+        "$KIMSEC" aes-ecb --key "$KEY" --format "$FORMAT" -o "$TMP/ct" "$TMP/pt" 2> /dev/null || fail "aes-ecb size $SIZE format $FORMAT encrypt"
+        "$KIMSEC" encode --format "$FORMAT" -o "$TMP/enc" "$TMP/pt" 2> /dev/null || fail "encode size $SIZE format $FORMAT"
+
+        CT_LEN=$(wc -c < "$TMP/ct")
+
+        # Text formats end in a newline, so chunks of the length without it fill the input exactly up to the newline
+        for CHUNK in 16 32 48 96 $CT_LEN $((CT_LEN - 1)) 1048576; do
+            [ "$CHUNK" -gt 0 ] || continue
+
+            for THREADS in 1 3; do
+                CASE="size $SIZE format $FORMAT chunk $CHUNK threads $THREADS"
+                CASES=$((CASES + 1))
+
+                "$KIMSEC" aes-ecb --decrypt --key "$KEY" --format "$FORMAT" --chunk-size "$CHUNK" --threads "$THREADS" \
+                    -o "$TMP/out" "$TMP/ct" 2> /dev/null && cmp -s "$TMP/out" "$TMP/pt" || fail "aes-ecb decrypt $CASE"
+
+                "$KIMSEC" aes-ecb --decrypt --key "$KEY" --format "$FORMAT" --chunk-size "$CHUNK" --threads "$THREADS" \
+                    -o "$TMP/out" - < "$TMP/ct" 2> /dev/null && cmp -s "$TMP/out" "$TMP/pt" || fail "aes-ecb decrypt stdin $CASE"
+
+                "$KIMSEC" decode --format "$FORMAT" --chunk-size "$CHUNK" --threads "$THREADS" \
+                    -o "$TMP/out" "$TMP/enc" 2> /dev/null && cmp -s "$TMP/out" "$TMP/pt" || fail "decode $CASE"
+            done
+        done
+    done
+done
+
+# Repeating-key XOR of a known plaintext, and back
+printf "Burning 'em, if you ain't quick and nimble\nI go crazy when I hear a cymbal" > "$TMP/ice"
+echo "0b3637272a2b2e63622c2e69692a23693a2a3c6324202d623d63343c2a26226324272765272a282b2f20430a652e2c652a3124333a653e2b2027630c692b20283165286326302e27282f" > "$TMP/expected"
+
+for THREADS in 1 3; do
+    "$KIMSEC" encode "$TMP/ice" 2> /dev/null | "$KIMSEC" xor --key ICE --chunk-size 16 --threads "$THREADS" 2> /dev/null | tr 'A-F' 'a-f' > "$TMP/out"
+    expect "xor threads $THREADS" "$TMP/expected" "$TMP/out"
+
+    "$KIMSEC" xor --key ICE --chunk-size 16 --threads "$THREADS" "$TMP/expected" 2> /dev/null | "$KIMSEC" decode 2> /dev/null > "$TMP/out"
+    expect "xor back threads $THREADS" "$TMP/ice" "$TMP/out"
+done
+
+# Single-byte XOR lines, with undecodable lines between them (the error messages are not compared)
+printf '1b37373331363f78151b7f2b783431333d78397828372d363c78373e783a393b3736\nzz\n\n123\n1b37373331363f78151b7f2b783431333d78397828372d363c78373e783a393b3736\n' > "$TMP/lines"
+printf "1\t18614\t58\tCooking MC's like a pound of bacon\n2\t-\t-\terror\n4\t-\t-\terror\n5\t18614\t58\tCooking MC's like a pound of bacon\n" > "$TMP/expected"
+
+for THREADS in 1 3; do
+    for CHUNK in 1 80 1048576; do
+        "$KIMSEC" crack-byte --chunk-size "$CHUNK" --threads "$THREADS" "$TMP/lines" 2> /dev/null \
+            | awk -F '\t' -v OFS='\t' '$2 == "-" { $4 = "error" } 1' > "$TMP/out"
+        expect "crack-byte chunk $CHUNK threads $THREADS" "$TMP/expected" "$TMP/out"
+    done
+done
+
+# Repeating-key XOR of English text, cracked alone and as a corpus with an undecodable file
+cat > "$TMP/english" << 'EOF'
+I'm back and I'm ringin' the bell, a rockin' on the mike while the fly girls yell. In ecstasy in the back of me,
+well that's my DJ Deshay cuttin' all them Z's, hittin' hard and the girlies goin' crazy. Vanilla's on the mike, man
+I'm not lazy. I'm lettin' my drug kick in, it controls my mouth and I begin to just let it flow, let my concepts go.
+My posse's to the side yellin', go Vanilla go! Smooth 'cause that's the way I will be, and if you don't give a damn,
+then why you starin' at me? So get off 'cause I control the stage, there's no dissin' allowed.
+EOF
+
+mkdir -p "$TMP/corpus/sub"
+"$KIMSEC" encode "$TMP/english" 2> /dev/null > "$TMP/english.hex"
+"$KIMSEC" xor --key YELLOW "$TMP/english.hex" 2> /dev/null > "$TMP/corpus/a.txt"
+"$KIMSEC" xor --key "Terminator X" "$TMP/english.hex" 2> /dev/null > "$TMP/corpus/sub/b.txt"
+echo "not hex" > "$TMP/corpus/bad.txt"
+
+"$KIMSEC" crack-repkey "$TMP/corpus/a.txt" 2> /dev/null > "$TMP/out"
+expect "crack-repkey" "$TMP/english" "$TMP/out"
+
+"$KIMSEC" crack-repkey - < "$TMP/corpus/sub/b.txt" 2> /dev/null > "$TMP/out"
+expect "crack-repkey stdin" "$TMP/english" "$TMP/out"
+
+printf "%s\t59454C4C4F57\n%s\t-\n%s\t5465726D696E61746F722058\n" "$TMP/corpus/a.txt" "$TMP/corpus/bad.txt" "$TMP/corpus/sub/b.txt" > "$TMP/expected"
+
+for THREADS in 1 3; do
+    "$KIMSEC" crack-corpus --threads "$THREADS" "$TMP/corpus" 2> /dev/null | cut -f 1,3 > "$TMP/out"
+    expect "crack-corpus threads $THREADS" "$TMP/expected" "$TMP/out"
+done
+
+# ECB detection, with a line without repeats and an undecodable line
+"$KIMSEC" aes-ecb --key "$KEY" "$TMP/english" 2> /dev/null > "$TMP/lines"
+echo "0g" >> "$TMP/lines"
+head -c 64 /dev/zero | "$KIMSEC" aes-ecb --key "$KEY" 2> /dev/null >> "$TMP/lines"
+printf "2\t-\n3\t3\n" > "$TMP/expected"
+
+for THREADS in 1 3; do
+    "$KIMSEC" detect-ecb --chunk-size 64 --threads "$THREADS" "$TMP/lines" 2> /dev/null | cut -f 1,2 > "$TMP/out"
+    expect "detect-ecb threads $THREADS" "$TMP/expected" "$TMP/out"
+done
+
+# Thread counts must be positive whole numbers
+for THREADS in -1 0 x; do
+    CASES=$((CASES + 1))
+    "$KIMSEC" encode --threads "$THREADS" < /dev/null > /dev/null 2>&1 && fail "encode accepted --threads $THREADS"
+done
+
+echo "kimsec tests: $CASES cases, $FAILED failed"
+
+[ "$FAILED" -eq 0 ]
@@ -7,8 +7,26 @@
 
 #include <fstream>
 #include <array>
+#include <vector>
+#include <tuple>
+#include <string_view>
+#include <algorithm>
+#include <iterator>
+#include <future>
+#include <atomic>
+#include <exception>
+#include <memory_resource>
+#include <type_traits>
+#include <variant>
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
 
+#include <cstdint>
 #include <cstddef>
+#include <cstring>
 
 #include "sec_xor.hpp"
 #include "sec_types.hpp"
@@ -17,50 +35,1131 @@ namespace kim
 {
     namespace sec
     {
-        static inline void rev_sub_bytes(std::array<std::array<std::byte, 4>, 4>& p_state_array)
+        /*** Compile-Time Tables ***/
+
+        namespace detail
+        {
+            /* Multiplication in GF(2^8) modulo x^8 + x^4 + x^3 + x + 1 */
+            constexpr uint8_t gf_mul(uint8_t p_lhs, uint8_t p_rhs)
+            {
+                uint8_t ret{};
+
+                for (; p_rhs; p_rhs >>= 1) {
+                    if (p_rhs & 0x01U) {
+                        ret ^= p_lhs;
+                    }
+
+                    p_lhs = static_cast<uint8_t>((p_lhs << 1) ^ ((p_lhs & 0x80U) ? 0x1BU : 0x00U));
+                }
+
+                return ret;
+            }
+
+            /* Multiplicative inverse in GF(2^8), computed as p^254 (0 maps to 0) */
+            constexpr uint8_t gf_inv(const uint8_t p_byte)
+            {
+                uint8_t ret{1};
+                uint8_t square{p_byte};
+
+                for (unsigned exp{254}; exp; exp >>= 1) {
+                    if (exp & 1U) {
+                        ret = gf_mul(ret, square);
+                    }
+
+                    square = gf_mul(square, square);
+                }
+
+                return ret;
+            }
+
+            constexpr uint8_t rotl8(const uint8_t p_byte, const unsigned p_shift)
+            {
+                return static_cast<uint8_t>((p_byte << p_shift) | (p_byte >> (8 - p_shift)));
+            }
+
+            constexpr uint32_t rotr32(const uint32_t p_word, const unsigned p_shift)
+            {
+                return (p_word >> p_shift) | (p_word << (32 - p_shift));
+            }
+
+            /* S-box: the inverse in GF(2^8) followed by the affine transformation of FIPS-197 5.1.1 */
+            constexpr std::array<uint8_t, 256> make_sbox()
+            {
+                std::array<uint8_t, 256> ret{};
+
+                for (std::size_t index{}; index < 256; index++) {
+                    const uint8_t inv{gf_inv(static_cast<uint8_t>(index))};
+
+                    ret[index] = static_cast<uint8_t>(inv ^ rotl8(inv, 1) ^ rotl8(inv, 2) ^ rotl8(inv, 3) ^ rotl8(inv, 4) ^ 0x63U);
+                }
+
+                return ret;
+            }
+
+            constexpr std::array<uint8_t, 256> make_inv_sbox(const std::array<uint8_t, 256>& p_sbox)
+            {
+                std::array<uint8_t, 256> ret{};
+
+                for (std::size_t index{}; index < 256; index++) {
+                    ret[p_sbox[index]] = static_cast<uint8_t>(index);
+                }
+
+                return ret;
+            }
+
+            /* Products of every byte with a fixed factor */
+            constexpr std::array<uint8_t, 256> make_gf_table(const uint8_t p_factor)
+            {
+                std::array<uint8_t, 256> ret{};
+
+                for (std::size_t index{}; index < 256; index++) {
+                    ret[index] = gf_mul(static_cast<uint8_t>(index), p_factor);
+                }
+
+                return ret;
+            }
+
+            /* Round constants x^(i - 1) for the key schedule, enough for AES-128 (AES-192 and AES-256 use fewer) */
+            constexpr std::array<uint8_t, 10> make_rcon()
+            {
+                std::array<uint8_t, 10> ret{};
+                uint8_t                 rcon{0x01};
+
+                for (auto& e : ret) {
+                    e = rcon;
+                    rcon = gf_mul(rcon, 0x02);
+                }
+
+                return ret;
+            }
+
+            /* T-tables: a column of one substituted byte through MixColumns (or its inverse), one table per byte rotation
+             * - Columns are words with row 0 in the most significant byte
+             */
+            constexpr std::array<std::array<uint32_t, 256>, 4> make_t_tables(const std::array<uint8_t, 256>& p_sbox,
+                                                                             const std::array<uint8_t, 4>& p_column)
+            {
+                std::array<std::array<uint32_t, 256>, 4> ret{};
+
+                for (std::size_t index{}; index < 256; index++) {
+                    const uint8_t sub{p_sbox[index]};
+
+                    ret[0][index] = (uint32_t{gf_mul(sub, p_column[0])} << 24) | (uint32_t{gf_mul(sub, p_column[1])} << 16)
+                                  | (uint32_t{gf_mul(sub, p_column[2])} << 8) | uint32_t{gf_mul(sub, p_column[3])};
+
+                    for (unsigned table{1}; table < 4; table++) {
+                        ret[table][index] = rotr32(ret[0][index], 8 * table);
+                    }
+                }
+
+                return ret;
+            }
+
+            constexpr bool is_inverse(const std::array<uint8_t, 256>& p_lhs, const std::array<uint8_t, 256>& p_rhs)
+            {
+                for (std::size_t index{}; index < 256; index++) {
+                    if (p_rhs[p_lhs[index]] != index) {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            constexpr uint32_t load_be32(const std::byte* p_bytes)
+            {
+                return (std::to_integer<uint32_t>(p_bytes[0]) << 24) | (std::to_integer<uint32_t>(p_bytes[1]) << 16)
+                     | (std::to_integer<uint32_t>(p_bytes[2]) << 8) | std::to_integer<uint32_t>(p_bytes[3]);
+            }
+
+            constexpr void store_be32(const uint32_t p_word, std::byte* p_bytes)
+            {
+                p_bytes[0] = static_cast<std::byte>(p_word >> 24);
+                p_bytes[1] = static_cast<std::byte>(p_word >> 16);
+                p_bytes[2] = static_cast<std::byte>(p_word >> 8);
+                p_bytes[3] = static_cast<std::byte>(p_word);
+            }
+        }
+
+        /* S-box and inverse S-box */
+        inline constexpr std::array<uint8_t, 256> aes_sbox{detail::make_sbox()};
+        inline constexpr std::array<uint8_t, 256> aes_inv_sbox{detail::make_inv_sbox(aes_sbox)};
+
+        /* Multiplication tables in GF(2^8), e.g. aes_gf_table<0x02> is xtime */
+        template <uint8_t Factor>
+        inline constexpr std::array<uint8_t, 256> aes_gf_table{detail::make_gf_table(Factor)};
+
+        /* Key schedule round constants */
+        inline constexpr std::array<uint8_t, 10> aes_rcon{detail::make_rcon()};
+
+        /* Encryption T-tables (SubBytes then MixColumns {02 01 01 03}) and decryption T-tables (InvSubBytes then InvMixColumns {0E 09 0D 0B}) */
+        inline constexpr std::array<std::array<uint32_t, 256>, 4> aes_te{detail::make_t_tables(aes_sbox, {0x02, 0x01, 0x01, 0x03})};
+        inline constexpr std::array<std::array<uint32_t, 256>, 4> aes_td{detail::make_t_tables(aes_inv_sbox, {0x0E, 0x09, 0x0D, 0x0B})};
+
+        static_assert(aes_sbox[0x00] == 0x63 && aes_sbox[0x53] == 0xED && aes_sbox[0xFF] == 0x16, "AES S-box does not match FIPS-197");
+        static_assert(detail::is_inverse(aes_sbox, aes_inv_sbox), "AES inverse S-box does not invert the S-box");
+        static_assert(aes_rcon[9] == 0x36, "AES round constants do not match FIPS-197");
+        static_assert(aes_te[0][0x00] == 0xC66363A5 && aes_te[3][0xFF] == 0x16163A2C, "AES encryption T-tables are wrong");
+        static_assert(aes_td[0][0x00] == 0x51F4A750 && aes_td[3][0x00] == 0xF4A75051, "AES decryption T-tables are wrong");
+
+
+        /*** Key Schedule ***/
+
+        /* Number of rounds for a 16, 24 or 32 byte key */
+        template <std::size_t KeyLength>
+        inline constexpr std::size_t aes_rounds{KeyLength / 4 + 6};
+
+        /* Expanded key for a 16, 24 or 32 byte key: one 16 byte round key per round plus the initial one */
+        template <std::size_t KeyLength>
+        using aes_key_schedule = std::array<std::byte, 16 * (aes_rounds<KeyLength> + 1)>;
+
+        /* AES-128 expanded key: 11 round keys of 16 bytes */
+        using aes_round_keys = aes_key_schedule<16>;
+
+        /*
+         * @brief Expands a 16, 24 or 32 byte AES key into its encryption round keys
+         *
+         * Usable in constant expressions, so schedules of fixed keys are computed at compile time.
+         *
+         * @param KeyLength Template parameter for the key length in bytes (16, 24 or 32)
+         *
+         * @param p_key The cipher key (kim::sec::ByteView)
+         *
+         * @return The expanded round keys (kim::sec::aes_key_schedule<KeyLength>)
+         */
+        template <std::size_t KeyLength>
+        constexpr aes_key_schedule<KeyLength> aes_key_expansion(const ByteView p_key)
+        {
+            static_assert(KeyLength == 16 || KeyLength == 24 || KeyLength == 32, "AES keys are 16, 24 or 32 bytes long");
+
+            if (p_key.length() != KeyLength) {
+                throw std::invalid_argument("AES key does not match the key length of the schedule");
+            }
+
+            constexpr std::size_t       key_words{KeyLength / 4};
+            aes_key_schedule<KeyLength> ret{};
+
+            for (std::size_t index{}; index < KeyLength; index++) {
+                ret[index] = p_key[index];
+            }
+
+            for (std::size_t word{key_words}; word < ret.size() / 4; word++) {
+                uint32_t tmp{detail::load_be32(ret.data() + (word - 1) * 4)};
+
+                if (word % key_words == 0) {
+                    /* RotWord, SubWord and Rcon */
+                    tmp = (uint32_t{aes_sbox[(tmp >> 16) & 0xFF]} << 24) | (uint32_t{aes_sbox[(tmp >> 8) & 0xFF]} << 16)
+                        | (uint32_t{aes_sbox[tmp & 0xFF]} << 8) | uint32_t{aes_sbox[tmp >> 24]};
+                    tmp ^= uint32_t{aes_rcon[word / key_words - 1]} << 24;
+                } else if (key_words > 6 && word % key_words == 4) {
+                    /* SubWord only, for AES-256 */
+                    tmp = (uint32_t{aes_sbox[tmp >> 24]} << 24) | (uint32_t{aes_sbox[(tmp >> 16) & 0xFF]} << 16)
+                        | (uint32_t{aes_sbox[(tmp >> 8) & 0xFF]} << 8) | uint32_t{aes_sbox[tmp & 0xFF]};
+                }
+
+                detail::store_be32(detail::load_be32(ret.data() + (word - key_words) * 4) ^ tmp, ret.data() + word * 4);
+            }
+
+            return ret;
+        }
+
+        /*
+         * @brief Expands a 16 byte AES-128 key into the 11 round keys
+         *
+         * @param p_key The cipher key (kim::sec::ByteView)
+         *
+         * @return The expanded round keys (kim::sec::aes_round_keys)
+         */
+        inline aes_round_keys aes_key_expansion(const ByteView p_key)
+        {
+            if (p_key.length() != 16) {
+                throw std::invalid_argument("AES-128 key is not 16 bytes long");
+            }
+
+            return aes_key_expansion<16>(p_key);
+        }
+
+        /*
+         * @brief Turns encryption round keys into the decryption round keys of the equivalent inverse cipher
+         *
+         * The round keys are reversed and InvMixColumns is applied to all but the first and last,
+         * which lets decryption use the same T-table round structure as encryption (FIPS-197 5.3.5).
+         *
+         * @param KeyLength Template parameter for the key length in bytes (16, 24 or 32)
+         *
+         * @param p_round_keys Encryption round keys (kim::sec::aes_key_schedule<KeyLength>)
+         *
+         * @return Decryption round keys (kim::sec::aes_key_schedule<KeyLength>)
+         */
+        template <std::size_t KeyLength>
+        constexpr aes_key_schedule<KeyLength> aes_inv_key_expansion(const aes_key_schedule<KeyLength>& p_round_keys)
+        {
+            constexpr std::size_t       rounds{aes_rounds<KeyLength>};
+            aes_key_schedule<KeyLength> ret{};
+
+            for (std::size_t round{}; round <= rounds; round++) {
+                const std::byte*    src{p_round_keys.data() + (rounds - round) * 16};
+                std::byte*          dst{ret.data() + round * 16};
+
+                for (std::size_t col{}; col < 16; col += 4) {
+                    if (round == 0 || round == rounds) {
+                        detail::store_be32(detail::load_be32(src + col), dst + col);
+                        continue;
+                    }
+
+                    const uint8_t a[4] = { std::to_integer<uint8_t>(src[col]), std::to_integer<uint8_t>(src[col + 1]),
+                                           std::to_integer<uint8_t>(src[col + 2]), std::to_integer<uint8_t>(src[col + 3]) };
+
+                    for (std::size_t row{}; row < 4; row++) {
+                        dst[col + row] = std::byte{static_cast<uint8_t>(aes_gf_table<0x0E>[a[row]] ^ aes_gf_table<0x0B>[a[(row + 1) % 4]]
+                                                                        ^ aes_gf_table<0x0D>[a[(row + 2) % 4]] ^ aes_gf_table<0x09>[a[(row + 3) % 4]])};
+                    }
+                }
+            }
+
+            return ret;
+        }
+
+        /* FIPS-197 A.1: the last AES-128 round key of 2B7E1516 28AED2A6 ABF71588 09CF4F3C, folded at compile time */
+        static_assert([] {
+            constexpr std::byte key[16] = { std::byte{0x2B}, std::byte{0x7E}, std::byte{0x15}, std::byte{0x16},
+                                            std::byte{0x28}, std::byte{0xAE}, std::byte{0xD2}, std::byte{0xA6},
+                                            std::byte{0xAB}, std::byte{0xF7}, std::byte{0x15}, std::byte{0x88},
+                                            std::byte{0x09}, std::byte{0xCF}, std::byte{0x4F}, std::byte{0x3C} };
+            constexpr aes_round_keys round_keys{aes_key_expansion<16>(ByteView{key, 16})};
+
+            return detail::load_be32(round_keys.data() + 160) == 0xD014F9A8 && detail::load_be32(round_keys.data() + 172) == 0xB6630CA6;
+        }(), "AES-128 key schedule does not match FIPS-197");
+
+
+        /*** Block Functions ***/
+
+        /*
+         * @brief Encrypts one 16 byte block with T-tables, fully unrolled for the key length
+         *
+         * @param KeyLength Template parameter for the key length in bytes (16, 24 or 32)
+         *
+         * @param p_in Plaintext block (const std::byte*)
+         * @param p_round_keys Encryption round keys (kim::sec::aes_key_schedule<KeyLength>)
+         * @param p_out Ciphertext block, which may be the plaintext block (std::byte*)
+         */
+        template <std::size_t KeyLength>
+        inline void aes_block_enc(const std::byte* p_in, const aes_key_schedule<KeyLength>& p_round_keys, std::byte* p_out)
+        {
+            const std::byte*    rk{p_round_keys.data()};
+            uint32_t            s0{detail::load_be32(p_in) ^ detail::load_be32(rk)};
+            uint32_t            s1{detail::load_be32(p_in + 4) ^ detail::load_be32(rk + 4)};
+            uint32_t            s2{detail::load_be32(p_in + 8) ^ detail::load_be32(rk + 8)};
+            uint32_t            s3{detail::load_be32(p_in + 12) ^ detail::load_be32(rk + 12)};
+
+            for (std::size_t round{1}; round < aes_rounds<KeyLength>; round++) {
+                rk += 16;
+
+                const uint32_t t0{aes_te[0][s0 >> 24] ^ aes_te[1][(s1 >> 16) & 0xFF] ^ aes_te[2][(s2 >> 8) & 0xFF] ^ aes_te[3][s3 & 0xFF] ^ detail::load_be32(rk)};
+                const uint32_t t1{aes_te[0][s1 >> 24] ^ aes_te[1][(s2 >> 16) & 0xFF] ^ aes_te[2][(s3 >> 8) & 0xFF] ^ aes_te[3][s0 & 0xFF] ^ detail::load_be32(rk + 4)};
+                const uint32_t t2{aes_te[0][s2 >> 24] ^ aes_te[1][(s3 >> 16) & 0xFF] ^ aes_te[2][(s0 >> 8) & 0xFF] ^ aes_te[3][s1 & 0xFF] ^ detail::load_be32(rk + 8)};
+                const uint32_t t3{aes_te[0][s3 >> 24] ^ aes_te[1][(s0 >> 16) & 0xFF] ^ aes_te[2][(s1 >> 8) & 0xFF] ^ aes_te[3][s2 & 0xFF] ^ detail::load_be32(rk + 12)};
+
+                s0 = t0;
+                s1 = t1;
+                s2 = t2;
+                s3 = t3;
+            }
+
+            /* Final round: SubBytes and ShiftRows without MixColumns */
+            rk += 16;
+
+            const auto last = [](const uint32_t p_a, const uint32_t p_b, const uint32_t p_c, const uint32_t p_d) {
+                return (uint32_t{aes_sbox[p_a >> 24]} << 24) | (uint32_t{aes_sbox[(p_b >> 16) & 0xFF]} << 16)
+                     | (uint32_t{aes_sbox[(p_c >> 8) & 0xFF]} << 8) | uint32_t{aes_sbox[p_d & 0xFF]};
+            };
+
+            detail::store_be32(last(s0, s1, s2, s3) ^ detail::load_be32(rk), p_out);
+            detail::store_be32(last(s1, s2, s3, s0) ^ detail::load_be32(rk + 4), p_out + 4);
+            detail::store_be32(last(s2, s3, s0, s1) ^ detail::load_be32(rk + 8), p_out + 8);
+            detail::store_be32(last(s3, s0, s1, s2) ^ detail::load_be32(rk + 12), p_out + 12);
+        }
+
+        /*
+         * @brief Decrypts one 16 byte block with T-tables, fully unrolled for the key length
+         *
+         * @param KeyLength Template parameter for the key length in bytes (16, 24 or 32)
+         *
+         * @param p_in Ciphertext block (const std::byte*)
+         * @param p_inv_round_keys Decryption round keys from aes_inv_key_expansion (kim::sec::aes_key_schedule<KeyLength>)
+         * @param p_out Plaintext block, which may be the ciphertext block (std::byte*)
+         */
+        template <std::size_t KeyLength>
+        inline void aes_block_dec(const std::byte* p_in, const aes_key_schedule<KeyLength>& p_inv_round_keys, std::byte* p_out)
+        {
+            const std::byte*    rk{p_inv_round_keys.data()};
+            uint32_t            s0{detail::load_be32(p_in) ^ detail::load_be32(rk)};
+            uint32_t            s1{detail::load_be32(p_in + 4) ^ detail::load_be32(rk + 4)};
+            uint32_t            s2{detail::load_be32(p_in + 8) ^ detail::load_be32(rk + 8)};
+            uint32_t            s3{detail::load_be32(p_in + 12) ^ detail::load_be32(rk + 12)};
+
+            for (std::size_t round{1}; round < aes_rounds<KeyLength>; round++) {
+                rk += 16;
+
+                const uint32_t t0{aes_td[0][s0 >> 24] ^ aes_td[1][(s3 >> 16) & 0xFF] ^ aes_td[2][(s2 >> 8) & 0xFF] ^ aes_td[3][s1 & 0xFF] ^ detail::load_be32(rk)};
+                const uint32_t t1{aes_td[0][s1 >> 24] ^ aes_td[1][(s0 >> 16) & 0xFF] ^ aes_td[2][(s3 >> 8) & 0xFF] ^ aes_td[3][s2 & 0xFF] ^ detail::load_be32(rk + 4)};
+                const uint32_t t2{aes_td[0][s2 >> 24] ^ aes_td[1][(s1 >> 16) & 0xFF] ^ aes_td[2][(s0 >> 8) & 0xFF] ^ aes_td[3][s3 & 0xFF] ^ detail::load_be32(rk + 8)};
+                const uint32_t t3{aes_td[0][s3 >> 24] ^ aes_td[1][(s2 >> 16) & 0xFF] ^ aes_td[2][(s1 >> 8) & 0xFF] ^ aes_td[3][s0 & 0xFF] ^ detail::load_be32(rk + 12)};
+
+                s0 = t0;
+                s1 = t1;
+                s2 = t2;
+                s3 = t3;
+            }
+
+            /* Final round: InvShiftRows and InvSubBytes without InvMixColumns */
+            rk += 16;
+
+            const auto last = [](const uint32_t p_a, const uint32_t p_b, const uint32_t p_c, const uint32_t p_d) {
+                return (uint32_t{aes_inv_sbox[p_a >> 24]} << 24) | (uint32_t{aes_inv_sbox[(p_b >> 16) & 0xFF]} << 16)
+                     | (uint32_t{aes_inv_sbox[(p_c >> 8) & 0xFF]} << 8) | uint32_t{aes_inv_sbox[p_d & 0xFF]};
+            };
+
+            detail::store_be32(last(s0, s3, s2, s1) ^ detail::load_be32(rk), p_out);
+            detail::store_be32(last(s1, s0, s3, s2) ^ detail::load_be32(rk + 4), p_out + 4);
+            detail::store_be32(last(s2, s1, s0, s3) ^ detail::load_be32(rk + 8), p_out + 8);
+            detail::store_be32(last(s3, s2, s1, s0) ^ detail::load_be32(rk + 12), p_out + 12);
+        }
+
+        /*
+         * @brief Calls a function with the key length as a compile-time constant
+         *
+         * @param Function Template parameter for a callable taking std::integral_constant<std::size_t, KeyLength>
+         *
+         * @param p_key_length Key length in bytes, which must be 16, 24 or 32 (std::size_t)
+         * @param p_func The function to call
+         *
+         * @return Whatever the function returns
+         */
+        template <class Function>
+        decltype(auto) aes_key_dispatch(const std::size_t p_key_length, Function&& p_func)
+        {
+            switch (p_key_length) {
+            case 16:
+                return p_func(std::integral_constant<std::size_t, 16>{});
+            case 24:
+                return p_func(std::integral_constant<std::size_t, 24>{});
+            case 32:
+                return p_func(std::integral_constant<std::size_t, 32>{});
+            default:
+                throw std::invalid_argument("AES key is not 16, 24 or 32 bytes long");
+            }
+        }
+
+        /*** Key Contexts ***/
+
+        /* Encryption and decryption round keys of one key, each starting on its own cache line */
+        template <std::size_t KeyLength>
+        struct alignas(64) aes_schedules
+        {
+            static constexpr std::size_t key_length{KeyLength};
+
+            alignas(64) aes_key_schedule<KeyLength> enc;
+            alignas(64) aes_key_schedule<KeyLength> dec;
+        };
+
+        /*
+         * Expanded AES key, for running many operations under the same key
+         * - Both key schedules are expanded once, at construction
+         * - The round count is resolved once per call, not once per block
+         */
+        class AesContext
+        {
+        public:
+            /*** Constructors ***/
+
+            /* Constructor which takes in a 16, 24 or 32 byte key (throws std::invalid_argument otherwise) */
+            explicit AesContext(const ByteView p_key)
+                : m_schedules{aes_key_dispatch(p_key.length(), [&](const auto p_key_length) -> schedules {
+                      constexpr std::size_t               key_length{decltype(p_key_length)::value};
+                      aes_schedules<key_length>           ret{};
+
+                      ret.enc = aes_key_expansion<key_length>(p_key);
+                      ret.dec = aes_inv_key_expansion<key_length>(ret.enc);
+
+                      return ret;
+                  })}
+            { }
+
+
+            /*** Public Methods ***/
+
+            /* Calls a function with the aes_schedules of the key */
+            template <class Function>
+            decltype(auto)  visit(Function&& p_func) const
+            {
+                return std::visit(std::forward<Function>(p_func), m_schedules);
+            }
+
+            /* Returns the key length in bytes */
+            std::size_t     key_length() const
+            {
+                return visit([](const auto& p_schedules) { return std::decay_t<decltype(p_schedules)>::key_length; });
+            }
+
+            /* Encrypts one 16 byte block (the output may be the input) */
+            void            enc_block(const std::byte* p_in, std::byte* p_out) const
+            {
+                visit([&](const auto& p_schedules) {
+                    aes_block_enc<std::decay_t<decltype(p_schedules)>::key_length>(p_in, p_schedules.enc, p_out);
+                });
+            }
+
+            /* Decrypts one 16 byte block (the output may be the input) */
+            void            dec_block(const std::byte* p_in, std::byte* p_out) const
+            {
+                visit([&](const auto& p_schedules) {
+                    aes_block_dec<std::decay_t<decltype(p_schedules)>::key_length>(p_in, p_schedules.dec, p_out);
+                });
+            }
+
+
+        private:
+            using schedules = std::variant<aes_schedules<16>, aes_schedules<24>, aes_schedules<32>>;
+
+            /*** Private Member Variables ***/
+
+            schedules m_schedules;
+        };
+
+        /*
+         * Least recently used cache of AesContext objects keyed by the key bytes
+         * - For oracle-style workloads that make thousands of calls with the same few keys
+         * - Safe to share between threads; contexts stay valid while a caller holds them, even once evicted
+         */
+        class AesKeyCache
+        {
+        public:
+            /*** Constructors ***/
+
+            /* Constructor which takes in the number of keys to keep (at least one) */
+            explicit AesKeyCache(const std::size_t p_capacity = 16) : m_capacity{std::max<std::size_t>(p_capacity, 1)} { }
+
+            AesKeyCache(const AesKeyCache&) = delete;
+            AesKeyCache& operator=(const AesKeyCache&) = delete;
+
+
+            /*** Public Methods ***/
+
+            /* Returns the context of a key, expanding it only if it is not cached */
+            std::shared_ptr<const AesContext> get(const ByteView p_key)
+            {
+                const std::string           key_str{reinterpret_cast<const char*>(p_key.data()), p_key.length()};
+                const std::lock_guard       lock{m_mutex};
+                const auto                  found{m_index.find(key_str)};
+
+                if (found != m_index.end()) {
+                    m_entries.splice(m_entries.begin(), m_entries, found->second);
+                    m_hits++;
+                    return found->second->second;
+                }
+
+                /* Expanded first, so that a bad key length throws before anything is counted or cached */
+                std::shared_ptr<const AesContext> context{std::make_shared<const AesContext>(p_key)};
+
+                m_misses++;
+                m_entries.emplace_front(key_str, std::move(context));
+                m_index.emplace(key_str, m_entries.begin());
+
+                if (m_entries.size() > m_capacity) {
+                    m_index.erase(m_entries.back().first);
+                    m_entries.pop_back();
+                }
+
+                return m_entries.front().second;
+            }
+
+            /* Returns the number of lookups that found their key */
+            std::size_t     hits() const
+            {
+                const std::lock_guard lock{m_mutex};
+
+                return m_hits;
+            }
+
+            /* Returns the number of lookups that expanded their key */
+            std::size_t     misses() const
+            {
+                const std::lock_guard lock{m_mutex};
+
+                return m_misses;
+            }
+
+
+        private:
+            using entry = std::pair<std::string, std::shared_ptr<const AesContext>>;
+
+            /*** Private Member Variables ***/
+
+            /* Most recently used first */
+            std::list<entry>                                                m_entries{};
+            std::unordered_map<std::string, std::list<entry>::iterator>     m_index{};
+            std::size_t                                                     m_capacity;
+            std::size_t                                                     m_hits{};
+            std::size_t                                                     m_misses{};
+            mutable std::mutex                                              m_mutex{};
+        };
+
+        namespace detail
         {
-            return;
+            /* Mode kernels over expanded keys (lengths are checked by the callers) */
+            template <std::size_t KeyLength>
+            Binary aes_ecb_enc(const ByteView p_pt, const aes_key_schedule<KeyLength>& p_round_keys)
+            {
+                Binary ret{p_pt};
+
+                for (std::size_t index{}; index < ret.length(); index += 16) {
+                    aes_block_enc<KeyLength>(ret.data() + index, p_round_keys, ret.data() + index);
+                }
+
+                return ret;
+            }
+
+            template <std::size_t KeyLength>
+            Binary aes_ecb_dec(const ByteView p_ct, const aes_key_schedule<KeyLength>& p_inv_round_keys)
+            {
+                Binary ret{p_ct};
+
+                for (std::size_t index{}; index < ret.length(); index += 16) {
+                    aes_block_dec<KeyLength>(ret.data() + index, p_inv_round_keys, ret.data() + index);
+                }
+
+                return ret;
+            }
+
+            template <std::size_t KeyLength>
+            Binary aes_cbc_enc(const ByteView p_pt, const aes_key_schedule<KeyLength>& p_round_keys, const ByteView p_iv)
+            {
+                Binary              ret{p_pt};
+                const std::byte*    chain{p_iv.data()};
+
+                for (std::size_t index{}; index < ret.length(); index += 16) {
+                    std::byte* const block{ret.data() + index};
+
+                    for (std::size_t k{}; k < 16; k++) {
+                        block[k] ^= chain[k];
+                    }
+
+                    aes_block_enc<KeyLength>(block, p_round_keys, block);
+                    chain = block;
+                }
+
+                return ret;
+            }
+
+            template <std::size_t KeyLength>
+            Binary aes_cbc_dec(const ByteView p_ct, const aes_key_schedule<KeyLength>& p_inv_round_keys, const ByteView p_iv)
+            {
+                Binary ret{p_ct};
+
+                for (std::size_t index{}; index < ret.length(); index += 16) {
+                    const std::byte* const prev{index ? p_ct.data() + index - 16 : p_iv.data()};
+
+                    aes_block_dec<KeyLength>(ret.data() + index, p_inv_round_keys, ret.data() + index);
+
+                    for (std::size_t k{}; k < 16; k++) {
+                        ret[index + k] ^= prev[k];
+                    }
+                }
+
+                return ret;
+            }
         }
 
-        static inline void rev_shift_rows(std::array<std::array<std::byte, 4>, 4>& p_state_array)
+        /*
+         * @brief Encrypts a buffer with AES in ECB mode
+         *
+         * @param p_pt Plaintext, a multiple of 16 bytes long (kim::sec::ByteView)
+         * @param p_key 16, 24 or 32 byte key (kim::sec::ByteView)
+         *
+         * @return Ciphertext (kim::sec::Binary)
+         */
+        inline Binary aes_ecb_enc(const ByteView p_pt, const ByteView p_key)
         {
-            return;
+            if (p_pt.length() % 16 != 0) {
+                throw std::invalid_argument("AES ECB plaintext is not a multiple of 16 bytes long");
+            }
+
+            return aes_key_dispatch(p_key.length(), [&](const auto p_key_length) {
+                constexpr std::size_t key_length{decltype(p_key_length)::value};
+
+                return detail::aes_ecb_enc<key_length>(p_pt, aes_key_expansion<key_length>(p_key));
+            });
         }
 
-        static inline void rev_mix_columns(std::array<std::array<std::byte, 4>, 4>& p_state_array)
+        /*
+         * @brief Encrypts a buffer with AES in ECB mode under an expanded key
+         *
+         * @param p_pt Plaintext, a multiple of 16 bytes long (kim::sec::ByteView)
+         * @param p_context Expanded key (kim::sec::AesContext)
+         *
+         * @return Ciphertext (kim::sec::Binary)
+         */
+        inline Binary aes_ecb_enc(const ByteView p_pt, const AesContext& p_context)
         {
-            return;
+            if (p_pt.length() % 16 != 0) {
+                throw std::invalid_argument("AES ECB plaintext is not a multiple of 16 bytes long");
+            }
+
+            return p_context.visit([&](const auto& p_schedules) {
+                return detail::aes_ecb_enc<std::decay_t<decltype(p_schedules)>::key_length>(p_pt, p_schedules.enc);
+            });
         }
 
-        static inline void add_round_key(std::array<std::array<std::byte, 4>, 4>& p_state_array)
+        /*
+         * @brief Decrypts a buffer with AES in ECB mode
+         *
+         * @param p_ct Ciphertext, a multiple of 16 bytes long (kim::sec::ByteView)
+         * @param p_key 16, 24 or 32 byte key (kim::sec::ByteView)
+         *
+         * @return Plaintext (kim::sec::Binary)
+         */
+        inline Binary aes_ecb_dec(const ByteView p_ct, const ByteView p_key)
         {
-            return;
+            if (p_ct.length() % 16 != 0) {
+                throw std::invalid_argument("AES ECB ciphertext is not a multiple of 16 bytes long");
+            }
+
+            KIM_SEC_PROBE(probe::aes_ecb_dec, p_ct.length());
+
+            return aes_key_dispatch(p_key.length(), [&](const auto p_key_length) {
+                constexpr std::size_t key_length{decltype(p_key_length)::value};
+
+                return detail::aes_ecb_dec<key_length>(p_ct, aes_inv_key_expansion<key_length>(aes_key_expansion<key_length>(p_key)));
+            });
+        }
+
+        /*
+         * @brief Decrypts a buffer with AES in ECB mode under an expanded key
+         *
+         * @param p_ct Ciphertext, a multiple of 16 bytes long (kim::sec::ByteView)
+         * @param p_context Expanded key (kim::sec::AesContext)
+         *
+         * @return Plaintext (kim::sec::Binary)
+         */
+        inline Binary aes_ecb_dec(const ByteView p_ct, const AesContext& p_context)
+        {
+            if (p_ct.length() % 16 != 0) {
+                throw std::invalid_argument("AES ECB ciphertext is not a multiple of 16 bytes long");
+            }
+
+            KIM_SEC_PROBE(probe::aes_ecb_dec, p_ct.length());
+
+            return p_context.visit([&](const auto& p_schedules) {
+                return detail::aes_ecb_dec<std::decay_t<decltype(p_schedules)>::key_length>(p_ct, p_schedules.dec);
+            });
+        }
+
+        /*
+         * @brief Decrypts a file containing AES ECB encrypted, PKCS#7 padded ciphertext
+         *
+         * @param Container Template parameter for the type of the ciphertext (kim::sec security type)
+         *
+         * @param p_Source The input file containing the ciphertext (kim::sec::FileSource)
+         * @param p_key 16, 24 or 32 byte key (kim::sec::Binary)
+         * @param p_Sink The output for the plaintext, padding removed (kim::sec::Sink)
+         */
+        template <class Container>
+        void aes_ecb_dec(FileSource p_Source, const Binary& p_key, Sink& p_Sink)
+        {
+            const Binary    full_ct_Bin{detail::from_text<Container>(p_Source.joined_lines())};
+            Binary          pt_Bin{aes_ecb_dec(full_ct_Bin.view(), p_key.view())};
+
+            pt_Bin.pkcs7_unpad();
+            p_Sink.write(pt_Bin.to_ASCII());
+        }
+
+        /*
+         * @brief Decrypts a file containing AES ECB encrypted, PKCS#7 padded ciphertext
+         *
+         * @param Container Template parameter for the type of the ciphertext (kim::sec security type)
+         *
+         * @param p_Source The input file containing the ciphertext (kim::sec::FileSource)
+         * @param p_key 16, 24 or 32 byte key (kim::sec::Binary)
+         * @param p_out_name The output file name (std::string)
+         *
+         * @return File with plaintext, padding removed, open for appending (std::ofstream)
+         */
+        template <class Container>
+        std::ofstream aes_ecb_dec(FileSource p_Source, const Binary& p_key, const std::string& p_out_name)
+        {
+            /* The writer thread overlaps the output with the decryption, the stream is only reopened for the caller */
+            {
+                FileSink sink{p_out_name};
+
+                aes_ecb_dec<Container>(std::move(p_Source), p_key, sink);
+                sink.close();
+            }
+
+            return std::ofstream{p_out_name, std::ios::app};
         }
 
+        /*
+         * @brief Decrypts a file containing AES ECB encrypted, PKCS#7 padded ciphertext
+         *
+         * @param Container Template parameter for the type of the ciphertext (kim::sec security type)
+         *
+         * @param p_in_File The input file containing the ciphertext (std::ifstream)
+         * @param p_key 16, 24 or 32 byte key (kim::sec::Binary)
+         * @param p_out_name The output file name (std::string)
+         *
+         * @return File with plaintext, padding removed (std::ofstream)
+         */
         template <class Container>
         std::ofstream aes_ecb_dec(std::ifstream& p_in_File, const Binary& p_key, const std::string& p_out_name)
         {
-            if (p_key.length() != 16) {
-                throw std::invalid_argument("AES ECB decryption key is not 16 bytes long");
+            return aes_ecb_dec<Container>(FileSource{p_in_File}, p_key, p_out_name);
+        }
+
+        /*
+         * @brief Encrypts a buffer with AES in CBC mode
+         *
+         * @param p_pt Plaintext, a multiple of 16 bytes long (kim::sec::ByteView)
+         * @param p_key 16, 24 or 32 byte key (kim::sec::ByteView)
+         * @param p_iv 16 byte initialisation vector (kim::sec::ByteView)
+         *
+         * @return Ciphertext, without the IV (kim::sec::Binary)
+         */
+        inline Binary aes_cbc_enc(const ByteView p_pt, const ByteView p_key, const ByteView p_iv)
+        {
+            if (p_iv.length() != 16) {
+                throw std::invalid_argument("AES CBC IV is not 16 bytes long");
+            }
+
+            if (p_pt.length() % 16 != 0) {
+                throw std::invalid_argument("AES CBC plaintext is not a multiple of 16 bytes long");
+            }
+
+            return aes_key_dispatch(p_key.length(), [&](const auto p_key_length) {
+                constexpr std::size_t key_length{decltype(p_key_length)::value};
+
+                return detail::aes_cbc_enc<key_length>(p_pt, aes_key_expansion<key_length>(p_key), p_iv);
+            });
+        }
+
+        /*
+         * @brief Encrypts a buffer with AES in CBC mode under an expanded key
+         *
+         * @param p_pt Plaintext, a multiple of 16 bytes long (kim::sec::ByteView)
+         * @param p_context Expanded key (kim::sec::AesContext)
+         * @param p_iv 16 byte initialisation vector (kim::sec::ByteView)
+         *
+         * @return Ciphertext, without the IV (kim::sec::Binary)
+         */
+        inline Binary aes_cbc_enc(const ByteView p_pt, const AesContext& p_context, const ByteView p_iv)
+        {
+            if (p_iv.length() != 16) {
+                throw std::invalid_argument("AES CBC IV is not 16 bytes long");
+            }
+
+            if (p_pt.length() % 16 != 0) {
+                throw std::invalid_argument("AES CBC plaintext is not a multiple of 16 bytes long");
             }
 
-            std::ofstream       ret{p_out_name};
-            std::string         full_ct{};
+            return p_context.visit([&](const auto& p_schedules) {
+                return detail::aes_cbc_enc<std::decay_t<decltype(p_schedules)>::key_length>(p_pt, p_schedules.enc, p_iv);
+            });
+        }
 
-            for (std::string curr_line{}; getline(p_in_File, curr_line);) {
-                full_ct += curr_line;
+        /*
+         * @brief Decrypts a buffer with AES in CBC mode
+         *
+         * @param p_ct Ciphertext without the IV, a multiple of 16 bytes long (kim::sec::ByteView)
+         * @param p_key 16, 24 or 32 byte key (kim::sec::ByteView)
+         * @param p_iv 16 byte initialisation vector (kim::sec::ByteView)
+         *
+         * @return Plaintext, padding included (kim::sec::Binary)
+         */
+        inline Binary aes_cbc_dec(const ByteView p_ct, const ByteView p_key, const ByteView p_iv)
+        {
+            if (p_iv.length() != 16) {
+                throw std::invalid_argument("AES CBC IV is not 16 bytes long");
             }
 
-            Binary      full_ct_Bin{Container{full_ct}};
+            if (p_ct.length() % 16 != 0) {
+                throw std::invalid_argument("AES CBC ciphertext is not a multiple of 16 bytes long");
+            }
+
+            return aes_key_dispatch(p_key.length(), [&](const auto p_key_length) {
+                constexpr std::size_t key_length{decltype(p_key_length)::value};
+
+                return detail::aes_cbc_dec<key_length>(p_ct, aes_inv_key_expansion<key_length>(aes_key_expansion<key_length>(p_key)), p_iv);
+            });
+        }
 
-            for (std::vector<std::byte>::size_type index{}; index < full_ct_Bin.length(); index += 16) {
+        /*
+         * @brief Decrypts a buffer with AES in CBC mode under an expanded key
+         *
+         * @param p_ct Ciphertext without the IV, a multiple of 16 bytes long (kim::sec::ByteView)
+         * @param p_context Expanded key (kim::sec::AesContext)
+         * @param p_iv 16 byte initialisation vector (kim::sec::ByteView)
+         *
+         * @return Plaintext, padding included (kim::sec::Binary)
+         */
+        inline Binary aes_cbc_dec(const ByteView p_ct, const AesContext& p_context, const ByteView p_iv)
+        {
+            if (p_iv.length() != 16) {
+                throw std::invalid_argument("AES CBC IV is not 16 bytes long");
+            }
+
+            if (p_ct.length() % 16 != 0) {
+                throw std::invalid_argument("AES CBC ciphertext is not a multiple of 16 bytes long");
+            }
+
+            return p_context.visit([&](const auto& p_schedules) {
+                return detail::aes_cbc_dec<std::decay_t<decltype(p_schedules)>::key_length>(p_ct, p_schedules.dec, p_iv);
+            });
+        }
+
+        /*
+         * @brief Encrypts a batch of independent 16 byte blocks with AES-128, each under its own key or one shared key
+         *
+         * Blocks are processed four at a time with their T-table rounds interleaved, so the independent
+         * lanes overlap in the pipeline instead of each block waiting on its own round chain.
+         *
+         * @param p_blocks Plaintext blocks, back to back (kim::sec::ByteView)
+         * @param p_keys One 16 byte key for every block, back to back, or a single shared key (kim::sec::ByteView)
+         *
+         * @return Ciphertext blocks, back to back (kim::sec::Binary)
+         */
+        inline Binary aes_ecb_enc_batch(const ByteView p_blocks, const ByteView p_keys)
+        {
+            constexpr std::size_t lanes{4};
+            constexpr std::size_t rounds{aes_rounds<16>};
+
+            if (p_blocks.length() % 16 != 0) {
+                throw std::invalid_argument("AES batch plaintext is not a multiple of 16 bytes long");
+            }
+
+            const bool shared{p_keys.length() == 16};
+
+            if (!shared && p_keys.length() != p_blocks.length()) {
+                throw std::invalid_argument("AES batch requires one key or one key per block");
+            }
+
+            const std::size_t                   count{p_blocks.length() / 16};
+            Binary                              ret{p_blocks};
+            std::byte*                          out{ret.data()};
+            std::array<aes_round_keys, lanes>   round_keys{};
+
+            if (shared && count) {
+                round_keys[0] = aes_key_expansion(p_keys);
+            }
+
+            for (std::size_t first{}; first < count; first += lanes) {
+                const std::size_t                           active{std::min(lanes, count - first)};
+                std::array<std::array<uint32_t, 4>, lanes>  states{};
+                std::array<const std::byte*, lanes>         keys{};
+
+                for (std::size_t lane{}; lane < active; lane++) {
+                    if (!shared) {
+                        round_keys[lane] = aes_key_expansion(p_keys.subview((first + lane) * 16, 16));
+                    }
+
+                    keys[lane] = round_keys[shared ? 0 : lane].data();
+
+                    for (std::size_t col{}; col < 4; col++) {
+                        states[lane][col] = detail::load_be32(out + (first + lane) * 16 + col * 4) ^ detail::load_be32(keys[lane] + col * 4);
+                    }
+                }
+
+                for (std::size_t round{1}; round < rounds; round++) {
+                    for (std::size_t lane{}; lane < active; lane++) {
+                        const std::array<uint32_t, 4>&  s{states[lane]};
+                        const std::byte*                rk{keys[lane] + round * 16};
+                        std::array<uint32_t, 4>         t{};
+
+                        for (std::size_t col{}; col < 4; col++) {
+                            t[col] = aes_te[0][s[col] >> 24] ^ aes_te[1][(s[(col + 1) % 4] >> 16) & 0xFF]
+                                   ^ aes_te[2][(s[(col + 2) % 4] >> 8) & 0xFF] ^ aes_te[3][s[(col + 3) % 4] & 0xFF]
+                                   ^ detail::load_be32(rk + col * 4);
+                        }
+
+                        states[lane] = t;
+                    }
+                }
+
+                for (std::size_t lane{}; lane < active; lane++) {
+                    const std::array<uint32_t, 4>&  s{states[lane]};
+                    const std::byte*                rk{keys[lane] + rounds * 16};
+
+                    for (std::size_t col{}; col < 4; col++) {
+                        const uint32_t word{(uint32_t{aes_sbox[s[col] >> 24]} << 24) | (uint32_t{aes_sbox[(s[(col + 1) % 4] >> 16) & 0xFF]} << 16)
+                                            | (uint32_t{aes_sbox[(s[(col + 2) % 4] >> 8) & 0xFF]} << 8) | uint32_t{aes_sbox[s[(col + 3) % 4] & 0xFF]}};
+
+                        detail::store_be32(word ^ detail::load_be32(rk + col * 4), out + (first + lane) * 16 + col * 4);
+                    }
+                }
+            }
+
+            return ret;
+        }
+
+        /*
+         * @brief Counts the repeated 16 byte blocks of a ciphertext, the tell of AES ECB
+         *
+         * Every block is hashed into a small open-addressing set, so the count is linear in the length.
+         * A trailing partial block is ignored.
+         *
+         * @param p_ct The ciphertext (kim::sec::ByteView)
+         * @param p_resource Memory resource for the set (std::pmr::memory_resource*)
+         *
+         * @return Number of blocks equal to an earlier block (std::size_t)
+         */
+        inline std::size_t aes_ecb_repeats(const ByteView p_ct, std::pmr::memory_resource* p_resource = std::pmr::get_default_resource())
+        {
+            const std::size_t blocks{p_ct.length() / 16};
 
+            if (blocks < 2) {
+                return 0;
             }
 
-            return std::ofstream{};
+            /* Power of two capacity at least twice the block count keeps probe chains short */
+            unsigned            shift{60};
+            std::size_t         capacity{16};
+
+            while (capacity < 2 * blocks) {
+                capacity *= 2;
+                shift--;
+            }
+
+            /* Slots hold the block index plus one, zero marks an empty slot (full width, mapped inputs can exceed 2^32 blocks) */
+            std::pmr::vector<std::size_t>   slots(capacity, 0, p_resource);
+            const std::byte*                data{p_ct.data()};
+            std::size_t                     ret{};
+
+            for (std::size_t index{}; index < blocks; index++) {
+                const std::byte*    block{data + index * 16};
+                std::uint64_t       lo{};
+                std::uint64_t       hi{};
+
+                std::memcpy(&lo, block, 8);
+                std::memcpy(&hi, block + 8, 8);
+
+                for (std::size_t slot{((lo ^ (hi * 0x9E3779B97F4A7C15ULL)) * 0xFF51AFD7ED558CCDULL) >> shift};; slot = (slot + 1) & (capacity - 1)) {
+                    if (slots[slot] == 0) {
+                        slots[slot] = index + 1;
+                        break;
+                    }
+
+                    if (std::memcmp(data + (slots[slot] - 1) * 16, block, 16) == 0) {
+                        ret++;
+                        break;
+                    }
+                }
+            }
+
+            return ret;
+        }
+
+        /*
+         * @brief Scans a file of ciphertexts, one per line, for ones encrypted with AES ECB
+         *
+         * The file is read through kim::sec::FileSource (memory mapped when it is a regular file) and its lines are handed
+         * out in batches to one task per thread of a kim::sec::ThreadPool. Each task decodes into its thread's arena, so
+         * lines are scanned without heap allocations. A line that cannot be decoded is skipped and reported in p_errors
+         * rather than stopping the scan.
+         *
+         * @param Container Template parameter for the type of the ciphertexts (kim::sec::Hex or kim::sec::Base64)
+         *
+         * @param p_file_name The input file name (std::string)
+         * @param p_threads Number of threads, 0 for one per hardware thread (std::size_t)
+         * @param p_errors Receives the lines which could not be decoded, in line order, nullptr to ignore them
+         *                 (std::vector<std::pair<std::size_t, std::string>>*) - Line Number (from 1) | Error
+         *
+         * @return Lines with at least one repeated block, most repeats first (std::vector<std::tuple<std::size_t, std::size_t, Container>>)
+         *         Repeated Blocks | Line Number (from 1) | Ciphertext
+         */
+        template <class Container>
+        std::vector<std::tuple<std::size_t, std::size_t, Container>> aes_ecb_detect(const std::string& p_file_name, const std::size_t p_threads = 0,
+                                                                                    std::vector<std::pair<std::size_t, std::string>>* p_errors = nullptr)
+        {
+            FileSource                      in_File{p_file_name};
+            std::vector<std::string_view>   lines{};
+
+            /* Lines of a mapped file stay valid for the life of the FileSource, streamed ones are kept here */
+            std::list<std::string>          copies{};
+
+            for (std::string_view line{}; in_File.next_line(line);) {
+                if (!in_File.mapped()) {
+                    line = copies.emplace_back(line);
+                }
+
+                lines.push_back(line);
+            }
+
+            using candidate = std::tuple<std::size_t, std::size_t, Container>;
+            using line_error = std::pair<std::size_t, std::string>;
+
+            constexpr std::size_t                   batch{64};
+            ThreadPool                              pool{p_threads};
+            const std::size_t                       tasks{std::min(pool.size(), std::max<std::size_t>((lines.size() + batch - 1) / batch, 1))};
+            std::atomic<std::size_t>                next_line{};
+            std::vector<std::vector<candidate>>     found(tasks);
+            std::vector<std::vector<line_error>>    errors(tasks);
+            std::vector<std::future<void>>          workers{};
+
+            for (std::size_t id{}; id < tasks; id++) {
+                workers.push_back(pool.submit([&, id] {
+                    Arena& arena{Arena::local()};
+
+                    for (std::size_t first{next_line.fetch_add(batch)}; first < lines.size(); first = next_line.fetch_add(batch)) {
+                        for (std::size_t index{first}; index < std::min(first + batch, lines.size()); index++) {
+                            if (lines[index].empty()) {
+                                continue;
+                            }
+
+                            std::size_t repeats{};
+
+                            try {
+                                const Container line_Con{lines[index], arena.resource()};
+                                repeats = aes_ecb_repeats(line_Con.to_Bin(arena.resource()).view(), arena.resource());
+                            } catch (const std::exception& e) {
+                                errors[id].emplace_back(index + 1, e.what());
+                            }
+
+                            arena.reset();
+
+                            if (repeats) {
+                                found[id].emplace_back(repeats, index + 1, detail::from_text<Container>(lines[index]));
+                            }
+                        }
+                    }
+                }));
+            }
+
+            for (std::future<void>& e : workers) {
+                e.get();
+            }
+
+            if (p_errors) {
+                for (std::vector<line_error>& e : errors) {
+                    std::move(e.begin(), e.end(), std::back_inserter(*p_errors));
+                }
+
+                std::sort(p_errors->begin(), p_errors->end(), [](const line_error& p_lhs, const line_error& p_rhs) { return p_lhs.first < p_rhs.first; });
+            }
+
+            std::vector<candidate> ret{};
+
+            for (std::vector<candidate>& e : found) {
+                std::move(e.begin(), e.end(), std::back_inserter(ret));
+            }
+
+            std::sort(ret.begin(), ret.end(), [](const candidate& p_lhs, const candidate& p_rhs) {
+                return std::get<0>(p_lhs) != std::get<0>(p_rhs) ? std::get<0>(p_lhs) > std::get<0>(p_rhs)
+                                                                 : std::get<1>(p_lhs) < std::get<1>(p_rhs);
+            });
+
+            return ret;
         }
 
     }
 }
 
-#endif /* SEC_AES */
\ No newline at end of file
+#endif /* SEC_AES */
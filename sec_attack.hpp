@@ -0,0 +1,455 @@
+/*
+ * @brief Attack Template Header File
+ * @author Edward Kim
+ */
+#ifndef SEC_ATTACK
+#define SEC_ATTACK
+
+#include <array>
+#include <vector>
+#include <random>
+#include <utility>
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <stdexcept>
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#include "sec_aes.hpp"
+#include "sec_types.hpp"
+
+namespace kim
+{
+    namespace sec
+    {
+        /* Random bytes for oracle keys and IVs, from one device per thread rather than one opened per call */
+        static inline Binary random_bytes(const std::size_t p_length)
+        {
+            thread_local std::random_device rng{};
+            Binary                          ret{};
+
+            ret.reserve(p_length);
+
+            for (std::size_t index{}; index < p_length; index += sizeof(std::random_device::result_type)) {
+                const std::random_device::result_type word{rng()};
+
+                for (std::size_t shift{}; shift < sizeof(word) && index + shift < p_length; shift++) {
+                    ret.push_back(static_cast<std::byte>(word >> (8 * shift)));
+                }
+            }
+
+            return ret;
+        }
+
+        /*
+         * Stand-in AES-128 ECB encryption oracle for Cryptopals 2.12 and 2.14
+         * - Encrypts prefix || input || secret, PKCS#7 padded, under a random key fixed at construction
+         * - Counts its queries, the cost metric of the attacks against it
+         */
+        class EcbOracle
+        {
+        public:
+            /*** Constructors ***/
+
+            /* Constructor which takes in the secret suffix and an optional fixed prefix */
+            explicit EcbOracle(const ByteView p_secret, const ByteView p_prefix = ByteView{})
+                : m_context{random_bytes(16).view()}, m_secret{p_secret}, m_prefix{p_prefix} { }
+
+
+            /*** Public Methods ***/
+
+            /* Returns the number of queries so far */
+            std::size_t     queries() const { return m_queries; }
+
+
+            /*** Public Member Operators ***/
+
+            /* Encrypts prefix || input || secret */
+            Binary          operator()(const ByteView p_input)
+            {
+                Binary pt{};
+
+                m_queries++;
+
+                pt.reserve(m_prefix.length() + p_input.length() + m_secret.length() + 16);
+                pt += m_prefix;
+                pt += p_input;
+                pt += m_secret;
+
+                return aes_ecb_enc(pt.pkcs7_pad().view(), m_context);
+            }
+
+
+        private:
+            /*** Private Member Variables ***/
+
+            AesContext      m_context;
+            Binary          m_secret;
+            Binary          m_prefix;
+            std::size_t     m_queries{};
+        };
+
+        /* 16 byte block packed into two words, as a dictionary key */
+        using ecb_block_key = std::pair<std::uint64_t, std::uint64_t>;
+
+        static inline ecb_block_key ecb_load_block(const std::byte* p_block)
+        {
+            ecb_block_key ret{};
+
+            std::memcpy(&ret.first, p_block, 8);
+            std::memcpy(&ret.second, p_block + 8, 8);
+
+            return ret;
+        }
+
+        /*
+         * @brief Recovers the secret suffix appended by an AES ECB encryption oracle, one byte at a time (Cryptopals 2.12/2.14)
+         *
+         * A fixed prefix before the attacker input is measured and aligned away first.
+         * Each byte then costs a single query, holding all 256 candidate blocks for its position followed by the
+         * aligned target block. Every position extends a different 15 byte context, so dictionaries are not reused.
+         *
+         * @param Oracle Template parameter for the oracle, callable as Binary(ByteView)
+         *               It must be deterministic and PKCS#7 pad what it encrypts
+         *
+         * @param p_oracle The encryption oracle
+         *
+         * @return The secret suffix (kim::sec::Binary)
+         */
+        template <class Oracle>
+        Binary ecb_byte_at_a_time(Oracle&& p_oracle)
+        {
+            constexpr std::size_t   block{16};
+            std::vector<std::byte>  query{};
+
+            const auto ask = [&]() {
+                Binary ret{p_oracle(ByteView{query.data(), query.size()})};
+
+                if (ret.length() % block != 0) {
+                    throw std::invalid_argument("Oracle ciphertext is not a multiple of 16 bytes long");
+                }
+
+                return ret;
+            };
+
+            /* Number of leading blocks identical for two different first input bytes: the prefix fills them entirely */
+            query.assign(1, std::byte{0x00});
+            const Binary    zero_ct{ask()};
+            query.assign(1, std::byte{0xFF});
+            const Binary    ones_ct{ask()};
+            std::size_t     prefix_blocks{};
+
+            while ((prefix_blocks + 1) * block <= zero_ct.length()
+                   && std::memcmp(zero_ct.data() + prefix_blocks * block, ones_ct.data() + prefix_blocks * block, block) == 0) {
+                prefix_blocks++;
+            }
+
+            if ((prefix_blocks + 1) * block > zero_ct.length()) {
+                throw std::invalid_argument("Oracle ciphertext does not depend on the input");
+            }
+
+            /* Alignment: shortest filler run that completes the block holding the end of the prefix, so that
+             * the differing byte after it no longer changes that block */
+            std::size_t align{1};
+
+            for (; align <= block; align++) {
+                query.assign(align + 1, std::byte{0x00});
+                const Binary lhs_ct{ask()};
+                query.back() = std::byte{0xFF};
+                const Binary rhs_ct{ask()};
+
+                if (std::memcmp(lhs_ct.data() + prefix_blocks * block, rhs_ct.data() + prefix_blocks * block, block) == 0) {
+                    break;
+                }
+            }
+
+            if (align > block) {
+                throw std::invalid_argument("Oracle does not encrypt with AES ECB");
+            }
+
+            /* First block after the prefix and the alignment */
+            const std::size_t start{align == block ? prefix_blocks * block : (prefix_blocks + 1) * block};
+
+            align %= block;
+
+            /* Secret length: PKCS#7 adds a whole block once prefix || input || secret fills the last one */
+            query.assign(align, std::byte{0x00});
+
+            const std::size_t   base_len{ask().length()};
+            std::size_t         secret_len{SIZE_MAX};
+
+            for (std::size_t extra{1}; extra <= block; extra++) {
+                query.assign(align + extra, std::byte{0x00});
+
+                if (ask().length() > base_len) {
+                    secret_len = base_len - start - extra;
+                    break;
+                }
+            }
+
+            if (secret_len == SIZE_MAX) {
+                throw std::invalid_argument("Oracle does not PKCS#7 pad its plaintext");
+            }
+
+            constexpr std::size_t                           candidates{256};
+            std::vector<std::pair<ecb_block_key, std::byte>>    dict{};
+            std::vector<std::byte>                              known(block - 1, std::byte{0x00});
+
+            dict.reserve(candidates);
+            known.reserve(block - 1 + secret_len);
+
+            for (std::size_t pos{}; pos < secret_len; pos++) {
+                /* Alignment, then the candidate blocks context || c, then the filler that puts byte pos last in a block */
+                query.assign(align, std::byte{0x00});
+
+                for (std::size_t byte{}; byte < candidates; byte++) {
+                    query.insert(query.end(), known.end() - (block - 1), known.end());
+                    query.push_back(static_cast<std::byte>(byte));
+                }
+
+                query.insert(query.end(), block - 1 - pos % block, std::byte{0x00});
+
+                const Binary ct{ask()};
+
+                if (start + (candidates + pos / block + 1) * block > ct.length()) {
+                    throw std::invalid_argument("Oracle ciphertext is shorter than expected");
+                }
+
+                const std::byte* data{ct.data() + start};
+
+                dict.clear();
+
+                for (std::size_t byte{}; byte < candidates; byte++) {
+                    dict.emplace_back(ecb_load_block(data + byte * block), static_cast<std::byte>(byte));
+                }
+
+                std::sort(dict.begin(), dict.end());
+
+                const ecb_block_key target{ecb_load_block(data + (candidates + pos / block) * block)};
+                const auto          match{std::lower_bound(dict.begin(), dict.end(), std::make_pair(target, std::byte{0x00}))};
+
+                if (match == dict.end() || match->first != target) {
+                    throw std::invalid_argument("Oracle is not deterministic");
+                }
+
+                known.push_back(match->second);
+            }
+
+            return Binary{ByteView{known.data() + block - 1, secret_len}};
+        }
+
+        /*
+         * Stand-in AES-128 CBC padding oracle for Cryptopals 3.17
+         * - Encrypts PKCS#7 padded plaintexts under a random key and IV
+         * - Answers whether a ciphertext decrypts to valid padding, safely from several threads at once
+         * - Counts its queries, the cost metric of the attacks against it
+         */
+        class CbcOracle
+        {
+        public:
+            /*** Constructors ***/
+
+            /* Empty Constructor, picks a random key */
+            CbcOracle() : m_context{random_bytes(16).view()} { }
+
+
+            /*** Public Methods ***/
+
+            /* Pads and encrypts a plaintext under a fresh random IV, returning { IV | Ciphertext } */
+            std::pair<Binary, Binary> encrypt(const ByteView p_pt) const
+            {
+                Binary iv{random_bytes(16)};
+                Binary pt{p_pt};
+                Binary ct{aes_cbc_enc(pt.pkcs7_pad().view(), m_context, iv.view())};
+
+                return std::make_pair(std::move(iv), std::move(ct));
+            }
+
+            /* Returns the number of padding queries so far */
+            std::size_t     queries() const { return m_queries.load(std::memory_order_relaxed); }
+
+
+            /*** Public Member Operators ***/
+
+            /* Returns true if the ciphertext decrypts to valid PKCS#7 padding, else false */
+            bool            operator()(const ByteView p_iv, const ByteView p_ct) const
+            {
+                m_queries.fetch_add(1, std::memory_order_relaxed);
+
+                if (p_ct.empty()) {
+                    return false;
+                }
+
+                if (p_iv.length() != 16 || p_ct.length() % 16 != 0) {
+                    throw std::invalid_argument("AES CBC ciphertext is not a multiple of 16 bytes long");
+                }
+
+                /* Only the last block carries the padding */
+                const ByteView  prev{p_ct.length() > 16 ? p_ct.subview(p_ct.length() - 32, 16) : p_iv};
+                std::byte       last[16];
+
+                m_context.dec_block(p_ct.data() + p_ct.length() - 16, last);
+
+                for (std::size_t index{}; index < 16; index++) {
+                    last[index] ^= prev[index];
+                }
+
+                return detail::pkcs7_pad_length(last, 16) != 0;
+            }
+
+
+        private:
+            /*** Private Member Variables ***/
+
+            AesContext                          m_context;
+            mutable std::atomic<std::size_t>    m_queries{};
+        };
+
+        /* Plaintext byte guesses, most likely first: English text by chr_score, then padding values, then the rest */
+        static inline const std::array<uint8_t, 256>& padding_guess_order()
+        {
+            static const std::array<uint8_t, 256> order{[] {
+                std::array<uint8_t, 256> ret{};
+
+                for (std::size_t index{}; index < 256; index++) {
+                    ret[index] = static_cast<uint8_t>(index);
+                }
+
+                const auto rank = [](const uint8_t p_byte) {
+                    return std::make_pair(chr_score(p_byte), p_byte >= 1 && p_byte <= 16);
+                };
+
+                std::stable_sort(ret.begin(), ret.end(), [&](const uint8_t p_lhs, const uint8_t p_rhs) {
+                    return rank(p_lhs) > rank(p_rhs);
+                });
+
+                return ret;
+            }()};
+
+            return order;
+        }
+
+        /*
+         * @brief Decrypts an AES CBC ciphertext with a padding oracle (Cryptopals 3.17)
+         *
+         * Every block is attacked on its own, as a one block ciphertext behind a forged IV, so blocks run
+         * concurrently on a thread pool. Guesses for each byte are tried in order of English plaintext likelihood.
+         * Once a block fails the others stop querying the oracle, and the error of the earliest failed block is thrown.
+         *
+         * @param Oracle Template parameter for the oracle, callable as bool(ByteView iv, ByteView ct) from several threads at once
+         *
+         * @param p_oracle The padding oracle
+         * @param p_iv 16 byte initialisation vector (kim::sec::ByteView)
+         * @param p_ct Ciphertext without the IV, a multiple of 16 bytes long (kim::sec::ByteView)
+         * @param p_threads Number of threads, 0 for one per hardware thread (std::size_t)
+         *
+         * @return Plaintext, padding included (kim::sec::Binary)
+         */
+        template <class Oracle>
+        Binary cbc_padding_oracle(Oracle&& p_oracle, const ByteView p_iv, const ByteView p_ct, const std::size_t p_threads = 0)
+        {
+            constexpr std::size_t block{16};
+
+            if (p_iv.length() != block) {
+                throw std::invalid_argument("AES CBC IV is not 16 bytes long");
+            }
+
+            if (p_ct.length() % block != 0) {
+                throw std::invalid_argument("AES CBC ciphertext is not a multiple of 16 bytes long");
+            }
+
+            const std::array<uint8_t, 256>& order{padding_guess_order()};
+            std::vector<std::byte>          pt(p_ct.length());
+
+            /* Set when a block fails, so the blocks still queued return at once instead of being attacked for nothing */
+            std::atomic<bool>               stop{};
+
+            const auto attack_block = [&](const std::size_t p_block) {
+                if (stop.load(std::memory_order_relaxed)) {
+                    return;
+                }
+
+                const ByteView              prev{p_block ? p_ct.subview((p_block - 1) * block, block) : p_iv};
+                const ByteView              target{p_ct.subview(p_block * block, block)};
+                std::array<std::byte, 16>   forged{};
+                std::array<std::byte, 16>   inter{};
+
+                std::copy(prev.begin(), prev.end(), forged.begin());
+
+                /* Decrypted target block before the XOR with the previous block, recovered from the back */
+                for (std::size_t pos{block}; pos-- > 0;) {
+                    const std::byte pad{static_cast<std::byte>(block - pos)};
+                    bool            found{};
+
+                    if (stop.load(std::memory_order_relaxed)) {
+                        return;
+                    }
+
+                    for (std::size_t k{pos + 1}; k < block; k++) {
+                        forged[k] = inter[k] ^ pad;
+                    }
+
+                    for (const uint8_t guess : order) {
+                        forged[pos] = static_cast<std::byte>(guess) ^ pad ^ prev[pos];
+
+                        if (!p_oracle(ByteView{forged.data(), forged.size()}, target)) {
+                            continue;
+                        }
+
+                        /* The last byte can also hit a longer valid padding, ruled out by changing the byte before it */
+                        if (pos == block - 1) {
+                            forged[pos - 1] ^= std::byte{0x01};
+                            const bool confirmed{p_oracle(ByteView{forged.data(), forged.size()}, target)};
+                            forged[pos - 1] ^= std::byte{0x01};
+
+                            if (!confirmed) {
+                                continue;
+                            }
+                        }
+
+                        inter[pos] = forged[pos] ^ pad;
+                        found = true;
+                        break;
+                    }
+
+                    if (!found) {
+                        throw std::invalid_argument("Padding oracle rejected every guess");
+                    }
+                }
+
+                for (std::size_t k{}; k < block; k++) {
+                    pt[p_block * block + k] = inter[k] ^ prev[k];
+                }
+            };
+
+            {
+                ThreadPool                      pool{p_threads};
+                std::vector<std::future<void>>  blocks{};
+
+                blocks.reserve(p_ct.length() / block);
+
+                for (std::size_t index{}; index < p_ct.length() / block; index++) {
+                    blocks.push_back(pool.submit([&attack_block, &stop, index] {
+                        try {
+                            attack_block(index);
+                        } catch (...) {
+                            stop.store(true, std::memory_order_relaxed);
+                            throw;
+                        }
+                    }));
+                }
+
+                for (std::future<void>& e : blocks) {
+                    e.get();
+                }
+            }
+
+            return Binary{ByteView{pt.data(), pt.size()}};
+        }
+    }
+}
+
+#endif /* SEC_ATTACK */
@@ -5,8 +5,17 @@
 #ifndef SEC_TYPES
 #define SEC_TYPES
 
+#include "types_view.hpp"
 #include "types_hex.hpp"
 #include "types_bin.hpp"
 #include "types_b64.hpp"
+#include "types_arena.hpp"
+#include "types_stats.hpp"
+#include "types_mmap.hpp"
+#include "types_pool.hpp"
+#include "types_source.hpp"
+#include "types_sink.hpp"
+#include "types_format.hpp"
+#include "types_checkpoint.hpp"
 
 #endif /* SEC_TYPES */
@@ -14,16 +14,120 @@
 #include <limits>
 #include <memory>
 #include <queue>
+#include <utility>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <future>
+#include <mutex>
+#include <memory_resource>
+#include <string>
+#include <sstream>
+#include <iterator>
 
+#include <cstring>
+
+#include "types_view.hpp"
 #include "types_bin.hpp"
+#include "types_hex.hpp"
+#include "types_b64.hpp"
+#include "types_arena.hpp"
+#include "types_stats.hpp"
+#include "types_source.hpp"
+#include "types_sink.hpp"
+#include "types_pool.hpp"
+#include "types_checkpoint.hpp"
 
 namespace kim
 {
     namespace sec
     {
+        namespace detail
+        {
+            /* Stack buffer for the arguments the templated XOR and Hamming decode, beyond which they decode onto the heap */
+            inline constexpr std::size_t scratch_bytes{4096};
+
+            /*
+             * @brief Returns the bytes of an argument to the templated XOR and Hamming
+             *
+             * Binary objects, byte views and byte vectors are used in place and a single byte is viewed where it is, so none
+             * of them is copied. Hex and Base64 objects are decoded, and strings (Binary or ASCII, as the Binary constructor
+             * takes them) parsed, straight into p_scratch's memory resource.
+             *
+             * @param Container Template parameter for the argument (std::string, std::byte, kim::sec::ByteView or kim::sec security type)
+             *
+             * @param p_con Argument
+             * @param p_scratch Empty Binary object which holds the bytes if they have to be converted, allocating from its memory resource
+             *
+             * @return The bytes, valid as long as p_con and p_scratch (kim::sec::ByteView)
+             */
+            template <class Container>
+            ByteView bytes_of(const Container& p_con, Binary& p_scratch)
+            {
+                if constexpr (std::is_same_v<Container, Binary>) {
+                    return p_con.view();
+                } else if constexpr (std::is_same_v<Container, ByteView>) {
+                    return p_con;
+                } else if constexpr (std::is_same_v<Container, std::vector<std::byte>>) {
+                    return ByteView{p_con.data(), p_con.size()};
+                } else if constexpr (std::is_same_v<Container, std::byte>) {
+                    return ByteView{&p_con, 1};
+                } else {
+                    /* Same memory resource, so the converted buffer is moved in rather than copied */
+                    if constexpr (std::is_same_v<Container, Hex> || std::is_same_v<Container, Base64>) {
+                        p_scratch = p_con.to_Bin(p_scratch.resource());
+                    } else {
+                        p_scratch = Binary{std::string_view{p_con}, p_scratch.resource()};
+                    }
+
+                    return p_scratch.view();
+                }
+            }
+        }
+
+        /*
+         * @brief Performs the XOR operation of two byte views
+         *
+         * @param lhs Left-hand side of XOR operation (kim::sec::ByteView)
+         * @param rhs Right-hand side of XOR operation (kim::sec::ByteView) - a single byte is XORed against every byte of lhs
+         *
+         * @return The kim::sec::Binary object result of the XOR operation
+         */
+        inline Binary XOR(const ByteView lhs, const ByteView rhs)
+        {
+            Binary ret{};
+
+            if (rhs.length() == 1) {
+                ret.reserve(lhs.length());
+
+                for (std::size_t index{}; index < lhs.length(); index++) {
+                    ret.push_back(lhs[index] ^ rhs[0]);
+                }
+
+                return ret;
+            }
+
+            if (lhs.length() != rhs.length()) {
+                throw std::invalid_argument("XOR operation of two buffers requires that they are equal in length");
+            }
+
+            ret.reserve(lhs.length());
+
+            for (std::size_t index{}; index < lhs.length(); index++) {
+                ret.push_back(lhs[index] ^ rhs[index]);
+            }
+
+            return ret;
+        }
+
         /*
          * @brief Performs the XOR operation of two kim::sec security types
          *
+         * Binary arguments are used by reference; Hex and Base64 arguments are decoded into a stack buffer
+         * (see detail::bytes_of), so only the result is allocated unless the inputs exceed detail::scratch_bytes.
+         *
          * @param Container1 Template parameter for lhs parameter (kim::sec security type)
          * @param Container2 Template parameter for rhs parameter (kim::sec security type) - defaults to std::byte if no template argument
          *
@@ -35,64 +139,150 @@ namespace kim
         template<class Container1, class Container2 = std::byte>
         Binary XOR(const Container1& lhs, const Container2& rhs)
         {
-            Binary      ret{};
-            Binary      lhs_Bin{lhs};
-            Binary      rhs_Bin{rhs};
+            std::array<std::byte, detail::scratch_bytes>    buffer;
+            std::pmr::monotonic_buffer_resource             scratch{buffer.data(), buffer.size()};
+            Binary                                          lhs_scratch{&scratch};
+            Binary                                          rhs_scratch{&scratch};
 
-            if (rhs_Bin.length() == 1) {
-                ret.reserve(lhs_Bin.length());
+            return XOR(detail::bytes_of(lhs, lhs_scratch), detail::bytes_of(rhs, rhs_scratch));
+        }
 
-                for (std::vector<std::byte>::size_type index{}; index < lhs_Bin.length(); index++) {
-                    ret.push_back(lhs_Bin[index] ^ rhs_Bin[0]);
+        /*
+         * @brief Performs the XOR operation of a batch of messages with a batch of keys
+         *
+         * Message i is XORed with key i, repeating the key when it is shorter than the message.
+         * Either batch may hold a single record, which is then paired with every record of the other.
+         * When every key is as long as its message the keys line up with the output, so the whole
+         * batch is XORed in one pass over contiguous buffers rather than record by record.
+         *
+         * @param p_msgs Messages (kim::sec::BatchView)
+         * @param p_keys Keys, none of them empty (kim::sec::BatchView)
+         *
+         * @return The results back to back, each as long as its message (kim::sec::Binary)
+         */
+        inline Binary XOR_batch(const BatchView p_msgs, const BatchView p_keys)
+        {
+            const std::size_t count{std::max(p_msgs.size(), p_keys.size())};
+
+            if ((p_msgs.size() != 1 && p_msgs.size() != count) || (p_keys.size() != 1 && p_keys.size() != count)) {
+                throw std::invalid_argument("XOR batch requires one message or key, or one key per message");
+            }
+
+            const auto msg = [&](const std::size_t p_index) { return p_msgs.size() == 1 ? p_msgs[0] : p_msgs[p_index]; };
+            const auto key = [&](const std::size_t p_index) { return p_keys.size() == 1 ? p_keys[0] : p_keys[p_index]; };
+
+            Binary ret{};
+
+            if (p_msgs.size() == count) {
+                ret = Binary{p_msgs.records()};
+            } else {
+                const Binary msg_Bin{p_msgs[0]};
+
+                ret.reserve(count * msg_Bin.length());
+
+                for (std::size_t index{}; index < count; index++) {
+                    ret += msg_Bin;
                 }
+            }
 
-                return ret;
+            std::byte*  out{ret.data()};
+            bool        aligned{p_keys.size() == count};
+
+            for (std::size_t index{}; aligned && index < count; index++) {
+                aligned = key(index).length() == msg(index).length();
             }
 
-            if (lhs_Bin.length() != rhs_Bin.length()) {
-                throw std::invalid_argument("XOR operation of two buffers requires that they are equal in length");
+            if (aligned) {
+                const std::byte* key_data{p_keys.records().data()};
+
+                for (std::size_t index{}; index < ret.length(); index++) {
+                    out[index] ^= key_data[index];
+                }
+
+                return ret;
             }
 
-            ret.reserve(lhs_Bin.length());
+            for (std::size_t index{}; index < count; index++) {
+                const ByteView      curr_key{key(index)};
+                const std::size_t   len{msg(index).length()};
 
-            for (std::vector<std::byte>::size_type index{}; index < lhs_Bin.length(); index++) {
-                ret.push_back(lhs_Bin[index] ^ rhs_Bin[index]);
+                if (curr_key.empty()) {
+                    throw std::invalid_argument("XOR batch key is empty");
+                }
+
+                if (curr_key.length() == 1) {
+                    for (std::size_t k{}; k < len; k++) {
+                        out[k] ^= curr_key[0];
+                    }
+                } else {
+                    for (std::size_t pos{}; pos < len; pos += curr_key.length()) {
+                        const std::size_t chunk{std::min(curr_key.length(), len - pos)};
+
+                        for (std::size_t k{}; k < chunk; k++) {
+                            out[pos + k] ^= curr_key[k];
+                        }
+                    }
+                }
+
+                out += len;
             }
 
             return ret;
         }
 
         /*
-         * @brief Decrypts a XOR byte encrypted ciphertext string
+         * @brief Scores how likely a byte is to appear in English ASCII text
          *
-         * @param Container Template parameter for input ciphertext (kim::sec security type)
+         * @param p_byte The byte (uint8_t)
          *
-         * @param p_Con Ciphertext (kim::sec security type)
+         * @return Letter frequency weight, higher for spaces and common letters, 0 for control and non-ASCII bytes (std::size_t)
+         */
+        inline std::size_t chr_score(const uint8_t p_byte)
+        {
+            static constexpr uint16_t chr_freq[] = { 609, 105, 284, 292, 1136, 179,
+                                                     138, 341, 544,  24,   41, 292,
+                                                     276, 544, 600, 195,   24, 495,
+                                                     568, 803, 243,  97,  138,  24,
+                                                     130,   3 };
+
+            /* Space */
+            if (p_byte == 32U) {
+                return 1217;
+            /* Alphabet */
+            } else if ((p_byte | 0x20U) >= 'a' && (p_byte | 0x20U) <= 'z') {
+                return chr_freq[(p_byte | 0x20U) - 'a'];
+            /* Numbers/Symbols */
+            } else if (p_byte > 32U && p_byte < 127U) {
+                return 16;
+            }
+
+            return 0;
+        }
+
+        /*
+         * @brief Decrypts a XOR byte encrypted ciphertext held in a byte view
          *
-         * @return A tuple consisting of { Score: std::size_t | Ciphertext: Container | Byte: Binary | Plaintext: std::string }
+         * @param p_view Ciphertext (kim::sec::ByteView)
+         *
+         * @return A tuple consisting of { Score: std::size_t | Ciphertext: ByteView | Byte: Binary | Plaintext: std::string }
+         *         Ties go to the smallest byte, as in XOR_byte_dec_batch
          */
-        template<class Container>
-        std::tuple<std::size_t, Container, Binary, std::string> XOR_byte_dec(const Container& p_Con)
+        inline std::tuple<std::size_t, ByteView, Binary, std::string> XOR_byte_dec(const ByteView p_view)
         {
-            using score_entry = std::tuple<std::size_t, Container, Binary, std::string>;
+            using score_entry = std::tuple<std::size_t, ByteView, Binary, std::string>;
+            using candidate = std::pair<std::size_t, uint8_t>;
 
-            /* Custom comparator */
+            /* Custom comparator: highest score on top, then smallest byte, rather than whatever the heap leaves there */
             auto cmp{
-                        [](const score_entry& lhs, const score_entry& rhs)
+                        [](const candidate& lhs, const candidate& rhs)
                         {
-                            return (std::get<0>(lhs) < std::get<0>(rhs));
+                            return lhs.first < rhs.first || (lhs.first == rhs.first && lhs.second > rhs.second);
                         }
                     };
 
-            /* Priority Queue of score entries */
-            std::priority_queue<score_entry, std::vector<score_entry>, decltype(cmp)> ret_pqueue(cmp);
+            /* Priority Queue of { Score | Byte } candidates, the plaintext is only built for the winner */
+            std::priority_queue<candidate, std::vector<candidate>, decltype(cmp)> ret_pqueue(cmp);
 
-            Binary              p_Con_Bin{p_Con};
-            const uint16_t      chr_freq[] = { 609, 105, 284, 292, 1136, 179,
-                                               138, 341, 544,  24,   41, 292,
-                                               276, 544, 600, 195,   24, 495,
-                                               568, 803, 243,  97,  138,  24,
-                                               130,   3 };
             const char*         nonprint_ASCII[] = { "(NUL)", "(SOH)", "(STX)", "(ETX)", "(EOT)",
                                                      "(ENQ)", "(ACK)", "(BEL)",  "(BS)",  "(HT)",
                                                       "(LF)",  "(VT)",  "(FF)",  "(CR)",  "(SO)",
@@ -101,62 +291,219 @@ namespace kim
                                                       "(EM)", "(SUB)", "(ESC)",  "(FS)",  "(GS)",
                                                       "(RS)",  "(US)" };
 
+            KIM_SEC_PROBE(probe::XOR_byte_dec, p_view.length());
+
+            if (p_view.empty()) {
+                return score_entry{};
+            }
+
             {
                 uint8_t i{};
                 do {
-                    Binary          XOR_result{XOR<Binary>(p_Con_Bin, std::byte{i})};
-                    std::string     ASCII_string{};
-                    std::size_t     score{};
+                    const std::byte     key_byte{i};
+                    std::size_t         score{};
+                    bool                valid{true};
 
-                    for (std::size_t k{}; k < XOR_result.length(); k++) {
-                        uint8_t byte_int{std::to_integer<uint8_t>(XOR_result[k])};
+                    for (std::size_t k{}; k < p_view.length(); k++) {
+                        uint8_t byte_int{std::to_integer<uint8_t>(p_view[k] ^ key_byte)};
 
                         /* Invalid ASCII */
                         if (!isascii(byte_int)) {
-                            ASCII_string = "";
+                            valid = false;
                             break;
-                        /* Unprintable ASCII */
-                        } else if (byte_int >= 0U && byte_int <= 31U) {
-                            ASCII_string += nonprint_ASCII[byte_int];
-                        /* DEL character */
-                        } else if (byte_int == 127U) {
-                            ASCII_string += "(DEL)";
-                        /* Space */
-                        } else if (byte_int == 32) {
-                            ASCII_string += ' ';
-                            score += 1217;
-                        /* Characters */
-                        } else {
-                            const char tmp_chr{static_cast<char>(byte_int)};
-
-                            /* Alphabet */
-                            if (isalpha(tmp_chr)) {
-                                score += chr_freq[toupper(tmp_chr) - 'A'];
-                            /* Numbers/Symbols */
-                            } else {
-                                score += 16;
-                            }
-
-                            ASCII_string += tmp_chr;
                         }
+
+                        score += chr_score(byte_int);
                     }
 
-                    if (!ASCII_string.empty()) {
-                        ret_pqueue.push(std::make_tuple(score, p_Con, Binary{std::byte{i}}, ASCII_string));
+                    if (valid) {
+                        ret_pqueue.emplace(score, i);
                     }
 
                 } while (i++ != UINT8_MAX);
             }
 
-            if (!ret_pqueue.empty()) {
-                return ret_pqueue.top();
-            } else {
+            if (ret_pqueue.empty()) {
                 return score_entry{};
             }
+
+            const std::byte     key_byte{ret_pqueue.top().second};
+            std::string         ASCII_string{};
+
+            ASCII_string.reserve(p_view.length());
+
+            for (std::size_t k{}; k < p_view.length(); k++) {
+                uint8_t byte_int{std::to_integer<uint8_t>(p_view[k] ^ key_byte)};
+
+                /* Unprintable ASCII */
+                if (byte_int <= 31U) {
+                    ASCII_string += nonprint_ASCII[byte_int];
+                /* DEL character */
+                } else if (byte_int == 127U) {
+                    ASCII_string += "(DEL)";
+                } else {
+                    ASCII_string += static_cast<char>(byte_int);
+                }
+            }
+
+            return score_entry{ret_pqueue.top().first, p_view, Binary{key_byte}, std::move(ASCII_string)};
         }
 
         /*
-         * @brief Decrypts a file with XOR byte encrypted ciphertext
+         * @brief Decrypts a XOR byte encrypted ciphertext string
+         *
+         * @param Container Template parameter for input ciphertext (kim::sec security type)
+         *
+         * @param p_Con Ciphertext (kim::sec security type)
+         *
+         * @return A tuple consisting of { Score: std::size_t | Ciphertext: Container | Byte: Binary | Plaintext: std::string }
+         */
+        template<class Container>
+        std::tuple<std::size_t, Container, Binary, std::string> XOR_byte_dec(const Container& p_Con)
+        {
+            using score_entry = std::tuple<std::size_t, Container, Binary, std::string>;
+
+            const Binary    p_Con_Bin{p_Con};
+            auto            best{XOR_byte_dec(p_Con_Bin.view())};
+
+            /* No candidate decrypted to valid ASCII */
+            if (std::get<3>(best).empty()) {
+                return score_entry{};
+            }
+
+            return score_entry{std::get<0>(best), p_Con, std::move(std::get<2>(best)), std::move(std::get<3>(best))};
+        }
+
+        namespace detail
+        {
+            /* Orders XOR_byte_dec candidates best first, so a set keeps the first candidate of every score */
+            struct score_greater
+            {
+                template <class Entry>
+                bool operator()(const Entry& lhs, const Entry& rhs) const
+                {
+                    return std::get<0>(lhs) > std::get<0>(rhs);
+                }
+            };
+
+            /*
+             * Scans the lines of a file for XOR byte encrypted ciphertexts, keeping the p_top_k best (0 for all)
+             * - With a checkpoint, restores its candidates and offset first, saves whenever it is due and once at the end
+             * - Snapshots carry the identity of the file, so one taken of a file that has changed since is refused
+             * - Candidates are saved as their ciphertext text and rebuilt with XOR_byte_dec, which is deterministic
+             */
+            template <class Container>
+            auto XOR_byte_scan(FileSource& p_Source, Checkpoint* p_Checkpoint, const std::size_t p_top_k)
+            {
+                using score_entry = std::tuple<std::size_t, Container, Binary, std::string>;
+
+                /* Set comprising of the best candidates in the format { Score: std::size_t | Ciphertext: Container | Byte: Binary | Plaintext: std::string } */
+                std::set<score_entry, score_greater> ret{};
+
+                /* Per-line scratch buffers come from an arena of the scan's own, rewound after every line
+                 * (the thread's arena may hold the caller's objects, so it must not be reset here) */
+                Arena arena{};
+
+                const std::string identity{p_Checkpoint ? file_identity(p_Source.file_name()) : std::string{}};
+
+                const auto insert = [&](const std::string_view p_line) {
+                    const Container     line_Con{from_text<Container>(p_line)};
+                    const Binary        line_Bin{line_Con.to_Bin(arena.resource())};
+                    auto                best_candidate{XOR_byte_dec(line_Bin.view())};
+
+                    if (std::get<0>(best_candidate)) {
+                        ret.emplace(std::get<0>(best_candidate), line_Con,
+                                    std::move(std::get<2>(best_candidate)), std::move(std::get<3>(best_candidate)));
+
+                        if (p_top_k && ret.size() > p_top_k) {
+                            ret.erase(std::prev(ret.end()));
+                        }
+                    }
+                };
+
+                /* Payload: offset of the next line | number of candidates | ciphertext text of each, best first */
+                const auto save = [&] {
+                    std::string payload{};
+
+                    put_u64(payload, p_Source.offset());
+                    put_u64(payload, ret.size());
+
+                    for (const score_entry& e : ret) {
+                        std::ostringstream os{};
+                        os << std::get<1>(e);
+                        put_bytes(payload, os.str());
+                    }
+
+                    p_Checkpoint->save(checkpoint_kind::byte_scan, identity, payload);
+                };
+
+                if (std::string payload{}; p_Checkpoint && p_Checkpoint->load(checkpoint_kind::byte_scan, identity, payload)) {
+                    std::string_view    rest{payload};
+                    const uint64_t      offset{get_u64(rest)};
+
+                    for (uint64_t count{get_u64(rest)}; count > 0; count--, arena.reset()) {
+                        insert(get_bytes(rest));
+                    }
+
+                    p_Source.seek(offset);
+                }
+
+                for (std::string_view line{}; p_Source.next_line(line); arena.reset()) {
+                    insert(line);
+
+                    if (p_Checkpoint && p_Checkpoint->due()) {
+                        save();
+                    }
+                }
+
+                if (p_Checkpoint) {
+                    save();
+                }
+
+                return ret;
+            }
+        }
+
+        /*
+         * @brief Decrypts a file with XOR byte encrypted ciphertext, one per line
+         *
+         * @param Container Template parameter for input ciphertext (kim::sec security type)
+         *
+         * @param p_Source Input file with the ciphertext (kim::sec::FileSource)
+         *
+         * @return A set with tuples in the form of { Score: std::size_t | Ciphertext: Container | Byte: Binary | Plaintext: std::string }
+         */
+        template <class Container>
+        auto XOR_byte_dec(FileSource p_Source)
+        {
+            return detail::XOR_byte_scan<Container>(p_Source, nullptr, 0);
+        }
+
+        /*
+         * @brief Decrypts a file with XOR byte encrypted ciphertext, one per line, checkpointing its progress
+         *
+         * Saves the offset of the next line and the candidates so far whenever the checkpoint is due, and again at the end.
+         * If the checkpoint already holds a snapshot of a scan, its candidates are restored and reading jumps to its offset,
+         * so a scan that was killed resumes with the result an uninterrupted one would have given. The snapshot must come
+         * from the same input and p_top_k. For a regular file this is checked against its path, size and modification time,
+         * throwing std::runtime_error if the file has changed; streams have no identity to check.
+         *
+         * @param Container Template parameter for input ciphertext (kim::sec security type)
+         *
+         * @param p_Source Input file with the ciphertext, at its start (kim::sec::FileSource)
+         * @param p_Checkpoint Snapshot file (kim::sec::Checkpoint)
+         * @param p_top_k Number of best candidates kept, 0 for all of them (std::size_t)
+         *
+         * @return A set with tuples in the form of { Score: std::size_t | Ciphertext: Container | Byte: Binary | Plaintext: std::string }
+         */
+        template <class Container>
+        auto XOR_byte_dec(FileSource p_Source, Checkpoint& p_Checkpoint, const std::size_t p_top_k = 0)
+        {
+            return detail::XOR_byte_scan<Container>(p_Source, &p_Checkpoint, p_top_k);
+        }
+
+        /*
+         * @brief Decrypts a file with XOR byte encrypted ciphertext, one per line
          *
          * @param Container Template parameter for input ciphertext (kim::sec security type)
          *
@@ -167,24 +514,86 @@ namespace kim
         template <class Container>
         auto XOR_byte_dec(std::ifstream p_File)
         {
-            using score_entry = std::tuple<std::size_t, Container, Binary, std::string>;
+            return XOR_byte_dec<Container>(FileSource{p_File});
+        }
 
-            /* Custom comparator */
-            auto cmp{
-                        [](const score_entry& lhs, const score_entry& rhs)
-                        {
-                            return (std::get<0>(lhs) > std::get<0>(rhs));
+        /*
+         * @brief Finds the most likely XOR byte key of every ciphertext in a batch
+         *
+         * Scores the same English model as XOR_byte_dec without building plaintexts. Each ciphertext byte adds
+         * a precomputed row of scores to all candidate keys at once, so the keys fill the SIMD lanes. A key only
+         * gives ASCII if its top bit matches that of every byte, so at most 128 keys are scored per record.
+         *
+         * @param p_cts Ciphertexts (kim::sec::BatchView)
+         *
+         * @return One { Score: std::size_t | Byte: std::byte } per ciphertext, ties going to the smallest byte as in XOR_byte_dec
+         *         (so kimsec crack-byte and XOR_byte_dec agree); score is 0 for an empty ciphertext or when no key gives ASCII
+         */
+        inline std::vector<std::pair<std::size_t, std::byte>> XOR_byte_dec_batch(const BatchView p_cts)
+        {
+            /* row[b][k] = chr_score(b ^ k) */
+            struct score_rows
+            {
+                std::uint32_t row[256][256];
+
+                score_rows()
+                {
+                    for (std::size_t byte{}; byte < 256; byte++) {
+                        for (std::size_t key{}; key < 256; key++) {
+                            row[byte][key] = static_cast<std::uint32_t>(chr_score(static_cast<uint8_t>(byte ^ key)));
                         }
-                    };
+                    }
+                }
+            };
+
+            /* 32 bit sums cannot overflow within a chunk */
+            constexpr std::size_t chunk_len{std::size_t{1} << 20};
+
+            static const score_rows                         rows{};
+            std::vector<std::pair<std::size_t, std::byte>>  ret(p_cts.size());
+            std::array<std::uint32_t, 128>                  chunk{};
+            std::array<std::uint64_t, 128>                  total{};
 
-            /* Set comprising of the best candidates in the format { Score: std::size_t | Ciphertext: Container | Byte: Binary | Plaintext: std::string } */
-            std::set<score_entry, decltype(cmp)> ret(cmp);
+            for (std::size_t index{}; index < p_cts.size(); index++) {
+                const ByteView  ct{p_cts[index]};
+                uint8_t         any{};
+                uint8_t         all{UINT8_MAX};
 
-            for (std::string line{}; getline(p_File, line);) {
-                score_entry best_candidate{XOR_byte_dec<Container>(Container{line})};
-                if (std::get<0>(best_candidate)) {
-                    ret.insert(best_candidate);
+                for (const std::byte e : ct) {
+                    any |= std::to_integer<uint8_t>(e);
+                    all &= std::to_integer<uint8_t>(e);
                 }
+
+                /* Empty, or the top bits differ so that every key leaves a non-ASCII byte */
+                if (ct.empty() || ((any ^ all) & 0x80U)) {
+                    continue;
+                }
+
+                const std::size_t key_base{all & 0x80U};
+
+                total.fill(0);
+
+                for (std::size_t pos{}; pos < ct.length(); pos += chunk_len) {
+                    const std::size_t end{std::min(ct.length(), pos + chunk_len)};
+
+                    chunk.fill(0);
+
+                    for (std::size_t k{pos}; k < end; k++) {
+                        const std::uint32_t* row{rows.row[std::to_integer<uint8_t>(ct[k])] + key_base};
+
+                        for (std::size_t key{}; key < 128; key++) {
+                            chunk[key] += row[key];
+                        }
+                    }
+
+                    for (std::size_t key{}; key < 128; key++) {
+                        total[key] += chunk[key];
+                    }
+                }
+
+                const std::size_t best{static_cast<std::size_t>(std::max_element(total.begin(), total.end()) - total.begin())};
+
+                ret[index] = std::make_pair(static_cast<std::size_t>(total[best]), static_cast<std::byte>(key_base + best));
             }
 
             return ret;
@@ -208,7 +617,7 @@ namespace kim
             }
 
             Binary      ret{};
-            Binary      p_pt_Bin{p_pt};
+            Binary      p_pt_Bin{ascii, p_pt};
 
             ret.reserve(p_pt_Bin.length());
 
@@ -220,7 +629,7 @@ namespace kim
                 ret.push_back(p_pt_Bin[pt_index] ^ p_key[key_index]);
             }
 
-            return Container{ret};
+            return Container{std::move(ret)};
         }
 
         /*
@@ -228,37 +637,80 @@ namespace kim
          *
          * @param Container Template parameter for the type of the ciphertext return (kim::sec security type)
          *
-         * @param p_in_File File with plaintext to encrypt (std::ifstream)
+         * @param p_Source File with plaintext to encrypt (kim::sec::FileSource)
          * @param p_key Key to use for encryption (kim::sec::Binary)
          *
          * @return Ciphertext in the specified kim::sec security type
          */
         template <class Container>
-        Container XOR_rep_key_enc(std::ifstream p_in_File, const Binary& p_key)
+        Container XOR_rep_key_enc(FileSource p_Source, const Binary& p_key)
         {
             if (p_key.empty()) {
                 throw std::invalid_argument("Key cannot be empty");
             }
 
-            Binary      ret{};
-            char        curr_chr{};
+            std::string_view    pt{p_Source.rest()};
+            Binary              ret{};
+
+            /* Files end with a trailing LF, which is not part of the plaintext */
+            if (!pt.empty() && pt.back() == '\n') {
+                pt.remove_suffix(1);
+            }
+
+            ret.reserve(pt.length());
 
-            for (std::size_t key_index{}; p_in_File.get(curr_chr); key_index++) {
+            for (std::size_t pt_index{}, key_index{}; pt_index < pt.length(); pt_index++, key_index++) {
                 if (key_index == p_key.length()) {
                     key_index = 0;
                 }
 
-                if (!isascii(curr_chr)) {
+                if (!isascii(pt[pt_index])) {
                     throw std::invalid_argument("Input file contains invalid ASCII");
                 }
 
-                ret.push_back(static_cast<std::byte>(curr_chr) ^ p_key[key_index]);
+                ret.push_back(static_cast<std::byte>(pt[pt_index]) ^ p_key[key_index]);
             }
 
-            /* Pop back one byte since files have a trailing LF */
-            ret.pop_back();
+            return Container{std::move(ret)};
+        }
 
-            return Container{ret};
+        /*
+         * @brief Encrypts a text file with repeating key XOR
+         *
+         * @param Container Template parameter for the type of the ciphertext return (kim::sec security type)
+         *
+         * @param p_in_File File with plaintext to encrypt (std::ifstream)
+         * @param p_key Key to use for encryption (kim::sec::Binary)
+         *
+         * @return Ciphertext in the specified kim::sec security type
+         */
+        template <class Container>
+        Container XOR_rep_key_enc(std::ifstream p_in_File, const Binary& p_key)
+        {
+            return XOR_rep_key_enc<Container>(FileSource{p_in_File}, p_key);
+        }
+
+        /*
+         * @brief Calculates the Hamming/edit distance between two byte views
+         *
+         * @param lhs Left-hand side of Hamming/edit distance calculation (kim::sec::ByteView)
+         * @param rhs Right-hand side of Hamming/edit distance calculation (kim::sec::ByteView)
+         *
+         * @return The Hamming/edit distance (std::size_t)
+         */
+        inline std::size_t Hamming(const ByteView lhs, const ByteView rhs)
+        {
+            std::size_t ret{};
+
+            if (lhs.length() != rhs.length()) {
+                throw std::invalid_argument("Inputs must be equal in length to compute the Hamming distance");
+            }
+
+            for (std::size_t index{}; index < lhs.length(); index++) {
+                ret += std::bitset<8>(std::to_integer<uint8_t>(lhs[index] ^ rhs[index])).count();
+            }
+
+            return ret;
         }
 
         /*
@@ -275,18 +727,129 @@ namespace kim
         template <class Container1, class Container2>
         std::size_t Hamming(const Container1& lhs, const Container2& rhs)
         {
-            std::size_t     ret{};
-            Binary          lhs_Bin{lhs};
-            Binary          rhs_Bin{rhs};
+            std::array<std::byte, detail::scratch_bytes>    buffer;
+            std::pmr::monotonic_buffer_resource             scratch{buffer.data(), buffer.size()};
+            Binary                                          lhs_scratch{&scratch};
+            Binary                                          rhs_scratch{&scratch};
 
-            if (lhs_Bin.length() != rhs_Bin.length()) {
-                throw std::invalid_argument("Inputs must be equal in length to compute the Hamming distance");
+            return Hamming(detail::bytes_of(lhs, lhs_scratch), detail::bytes_of(rhs, rhs_scratch));
+        }
+
+        /* Key recovered from a repeating key XOR ciphertext, with how English its plaintext looks */
+        struct rep_key_guess
+        {
+            Binary          key{};
+            std::size_t     score{};        /* Sum of chr_score over the plaintext */
+            double          confidence{};   /* Mean chr_score per plaintext byte over that of a space, from 0 to 1 (English prose scores about 0.5) */
+        };
+
+        /*
+         * @brief Recovers the key of a repeating key XOR ciphertext
+         *
+         * Ranks the key sizes from 2 to 40 bytes by the normalised Hamming distance between neighbouring blocks, then cracks
+         * the closest few and their divisors: each transposes the ciphertext into one column per key byte in scratch memory
+         * and scores every column in one XOR_byte_dec_batch call. Multiples of the true size decrypt just as well and, with
+         * fewer bytes per column, score a little higher by chance, so the smallest size within 5% of the best score wins.
+         * The only heap allocations are the key and the per-size column scores when p_resource is an arena.
+         *
+         * @param p_ct Ciphertext (kim::sec::ByteView)
+         * @param p_resource Memory resource for the scratch columns (std::pmr::memory_resource*)
+         *
+         * @return Key and score (kim::sec::rep_key_guess), all empty for an empty ciphertext
+         */
+        inline rep_key_guess XOR_rep_key_crack(const ByteView p_ct, std::pmr::memory_resource* p_resource = std::pmr::get_default_resource())
+        {
+            constexpr std::size_t   max_keysize{40};
+            constexpr std::size_t   shortlist{4};
+
+            const std::size_t       ct_length{p_ct.length()};
+            rep_key_guess           ret{};
+
+            if (ct_length == 0) {
+                return ret;
             }
 
-            for (std::vector<std::byte>::size_type index{}; index < lhs.length(); index++) {
-                ret += std::bitset<8>(static_cast<uint8_t>(lhs_Bin[index] ^ rhs_Bin[index])).count();
+            /* { Distance in thousandths of a bit per byte | Key size }, for the sizes with at least two whole blocks */
+            std::array<std::pair<std::size_t, std::size_t>, max_keysize - 1>    distances{};
+            std::size_t                                                         sizes{};
+
+            for (std::size_t keysize_guess{2}; keysize_guess <= max_keysize && 2 * keysize_guess <= ct_length; keysize_guess++) {
+                std::size_t     curr_hamming{};
+                std::size_t     count{};
+
+                for (; (count + 2) * keysize_guess <= ct_length; count++) {
+                    curr_hamming += Hamming(p_ct.subview(count * keysize_guess, keysize_guess), p_ct.subview((count + 1) * keysize_guess, keysize_guess));
+                }
+
+                distances[sizes++] = {curr_hamming * 1000 / (keysize_guess * count), keysize_guess};
             }
 
+            /* Too short for two blocks of any size: one column per byte up to the smallest size */
+            if (sizes == 0) {
+                distances[sizes++] = {0, std::min<std::size_t>(2, ct_length)};
+            }
+
+            std::partial_sort(distances.begin(), distances.begin() + static_cast<std::ptrdiff_t>(std::min(shortlist, sizes)),
+                              distances.begin() + static_cast<std::ptrdiff_t>(sizes));
+
+            /* Sizes to crack: the shortlist and every divisor of it, which its multiples would otherwise shadow */
+            std::array<bool, max_keysize + 1> tried{};
+
+            for (std::size_t candidate{}; candidate < std::min(shortlist, sizes); candidate++) {
+                for (std::size_t divisor{std::min<std::size_t>(2, distances[candidate].second)}; divisor <= distances[candidate].second; divisor++) {
+                    tried[divisor] = tried[divisor] || distances[candidate].second % divisor == 0;
+                }
+            }
+
+            /* Column k holds bytes k, k + keysize, ... back to back, column k starting at offsets[k] */
+            std::pmr::vector<std::byte>     columns(ct_length, p_resource);
+            std::pmr::vector<std::size_t>   offsets(max_keysize + 1, 0, p_resource);
+
+            const auto crack = [&](const std::size_t p_keysize) {
+                for (std::size_t column{}; column < p_keysize; column++) {
+                    offsets[column + 1] = offsets[column] + (ct_length - column + p_keysize - 1) / p_keysize;
+
+                    for (std::size_t index{column}, out{offsets[column]}; index < ct_length; index += p_keysize, out++) {
+                        columns[out] = p_ct[index];
+                    }
+                }
+
+                return XOR_byte_dec_batch(BatchView{ByteView{columns.data(), columns.size()}, offsets.data(), p_keysize});
+            };
+
+            const auto total = [](const std::vector<std::pair<std::size_t, std::byte>>& p_keys) {
+                std::size_t score{};
+
+                for (const std::pair<std::size_t, std::byte>& e : p_keys) {
+                    score += e.first;
+                }
+
+                return score;
+            };
+
+            std::array<std::size_t, max_keysize + 1>    scores{};
+            std::size_t                                 best{};
+
+            for (std::size_t keysize_guess{1}; keysize_guess <= max_keysize; keysize_guess++) {
+                if (tried[keysize_guess]) {
+                    scores[keysize_guess] = total(crack(keysize_guess));
+                    best = std::max(best, scores[keysize_guess]);
+                }
+            }
+
+            std::size_t keysize{1};
+
+            while (!tried[keysize] || scores[keysize] * 100 < best * 95) {
+                keysize++;
+            }
+
+            for (const std::pair<std::size_t, std::byte>& e : crack(keysize)) {
+                ret.key.push_back(e.second);
+                ret.score += e.first;
+            }
+
+            ret.confidence = static_cast<double>(ret.score) / (static_cast<double>(chr_score(' ')) * ct_length);
+
             return ret;
         }
 
@@ -295,71 +858,299 @@ namespace kim
          *
          * @param Container Template parameter for the type of the ciphertext (kim::sec security type)
          *
-         * @param p_in_File The input file containing the ciphertext (std::ifstream)
-         * @param p_out_name The output file name (std::string)
-         *
-         * @return File with plaintext (std::ofstream)
+         * @param p_Source The input file containing the ciphertext (kim::sec::FileSource)
+         * @param p_Sink The output for the plaintext (kim::sec::Sink)
          */
         template <class Container>
-        std::ofstream XOR_rep_key_dec(std::ifstream p_in_File, const std::string& p_out_name)
+        void XOR_rep_key_dec(FileSource p_Source, Sink& p_Sink)
         {
-            std::ofstream       ret{p_out_name};
-            std::string         full_ct{};
+            const std::string_view  full_ct{p_Source.joined_lines()};
+
+            KIM_SEC_PROBE(probe::XOR_rep_key_dec, full_ct.length());
 
-            for (std::string curr_line{}; getline(p_in_File, curr_line); full_ct += curr_line) { }
+            Binary                  pt_Bin{};
 
-            Binary                  full_ct_Bin{Container{full_ct}};
-            const std::size_t       full_ct_Bin_length{full_ct_Bin.length()};
-            uint8_t                 keysize{2};
+            {
+                /* Scratch for the crack, freed with it (the thread's arena may hold the caller's objects) */
+                Arena               arena{};
+                const Binary        full_ct_Bin{detail::from_text<Container>(full_ct)};
+                const Binary        key{XOR_rep_key_crack(full_ct_Bin.view(), arena.resource()).key};
+
+                pt_Bin.reserve(full_ct_Bin.length());
+
+                for (std::size_t ct_index{}, key_index{}; ct_index < full_ct_Bin.length(); ct_index++, key_index++) {
+                    if (key_index == key.length()) {
+                        key_index = 0;
+                    }
 
-            for (std::size_t keysize_guess{2}, min_hamming_norm{std::numeric_limits<std::size_t>::max()}; keysize_guess <= 40U; keysize_guess++) {
-                if (keysize_guess > full_ct_Bin_length) {
-                    break;
+                    pt_Bin.push_back(key[key_index] ^ full_ct_Bin[ct_index]);
                 }
+            }
+
+            p_Sink.write(pt_Bin.to_ASCII());
+        }
+
+        /* One file of a corpus cracked by XOR_rep_key_dec_corpus */
+        struct rep_key_report
+        {
+            std::string     file{};
+            std::size_t     size{};         /* Bytes of ciphertext after decoding */
+            rep_key_guess   guess{};
+            std::string     error{};        /* Why the file could not be cracked, empty on success */
+        };
+
+        /*
+         * @brief Recovers the repeating XOR key of every file in a corpus
+         *
+         * Directories are searched recursively for regular files. The files are handed out largest first to
+         * one task per thread of a kim::sec::ThreadPool, which keeps the threads busy until the smallest files
+         * are left, so the wall time scales with the number of cores rather than the number of files. Each task
+         * decodes and transposes into its thread's arena and scores with the shared tables of XOR_byte_dec_batch.
+         * A file or directory that cannot be read, or a file that cannot be decoded, gets an error in its entry rather than
+         * stopping the run.
+         *
+         * With a checkpoint, the reports of the files done so far are saved whenever it is due and again at the end.
+         * Files already in a snapshot are taken from it instead of being cracked again, so a killed sweep resumes
+         * with only the files it had not finished. Each report is saved with the size and modification time of its
+         * file, and files that have changed since are cracked again.
+         *
+         * @param Container Template parameter for the type of the ciphertexts (kim::sec::Hex or kim::sec::Base64)
+         *
+         * @param p_paths Files and directories (std::vector<std::string>)
+         * @param p_threads Number of threads, 0 for one per hardware thread (std::size_t)
+         * @param p_Checkpoint Snapshot file, nullptr for none (kim::sec::Checkpoint*)
+         *
+         * @return One entry per file, in path order (std::vector<kim::sec::rep_key_report>)
+         */
+        template <class Container>
+        std::vector<rep_key_report> XOR_rep_key_dec_corpus(const std::vector<std::string>& p_paths, const std::size_t p_threads = 0,
+                                                           Checkpoint* p_Checkpoint = nullptr)
+        {
+            std::vector<rep_key_report> ret{};
 
-                std::size_t     curr_hamming_norm{};
-                std::size_t     count{1};
-                for (; (count + 1) * keysize_guess - 1 <= full_ct_Bin_length; count++) {
-                    curr_hamming_norm += Hamming<Binary, Binary>(full_ct_Bin.subBin(0, keysize_guess),
-                                                                 full_ct_Bin.subBin(count * keysize_guess, keysize_guess));
+            /* Nothing here throws, so an unreadable directory or a file that vanishes only gets an error in its entry */
+            const auto add = [&](const std::string& p_file, const std::error_code p_error, const std::uintmax_t p_size) {
+                ret.push_back(rep_key_report{p_file, p_error ? 0 : static_cast<std::size_t>(p_size), {}, p_error ? p_error.message() : ""});
+            };
+
+            for (const std::string& path : p_paths) {
+                std::error_code error{};
+
+                if (!std::filesystem::is_directory(path, error)) {
+                    const std::uintmax_t size{std::filesystem::file_size(path, error)};
+
+                    add(path, error, size);
+                    continue;
                 }
-                curr_hamming_norm /= (keysize_guess * count);
 
-                if (curr_hamming_norm < min_hamming_norm) {
-                    min_hamming_norm = curr_hamming_norm;
-                    keysize = keysize_guess;
+                /* Directories are walked by hand so that one which cannot be read gets an error and the walk goes on */
+                std::vector<std::filesystem::path> dirs{path};
+
+                while (!dirs.empty()) {
+                    const std::filesystem::path dir{std::move(dirs.back())};
+
+                    dirs.pop_back();
+                    error.clear();
+
+                    for (std::filesystem::directory_iterator it{dir, error}; !error && it != std::filesystem::directory_iterator{}; it.increment(error)) {
+                        std::error_code entry_error{};
+
+                        /* Symbolic links to directories are not followed, as with recursive_directory_iterator */
+                        if (it->symlink_status(entry_error).type() == std::filesystem::file_type::directory) {
+                            dirs.push_back(it->path());
+                        } else if (it->is_regular_file(entry_error)) {
+                            const std::uintmax_t size{it->file_size(entry_error)};
+
+                            add(it->path().string(), entry_error, size);
+                        } else if (entry_error) {
+                            add(it->path().string(), entry_error, 0);
+                        }
+                    }
+
+                    if (error) {
+                        add(dir.string(), error, 0);
+                    }
                 }
             }
 
-            std::unique_ptr<Binary[]>       XOR_byte_blocks = std::make_unique<Binary[]>(keysize);
-            Binary                          key{};
-            Binary                          pt_Bin{};
+            std::sort(ret.begin(), ret.end(), [](const rep_key_report& lhs, const rep_key_report& rhs) { return lhs.file < rhs.file; });
 
-            for (std::vector<std::byte>::size_type ct_block_index{}; ct_block_index < full_ct_Bin_length; ct_block_index += keysize) {
-                for (std::vector<std::byte>::size_type keysize_index{}; keysize_index < keysize; keysize_index++) {
-                    if (ct_block_index + keysize_index > full_ct_Bin_length) {
-                        break;
+            /* Payload: number of reports | file, identity, size, key, score, confidence (IEEE 754 bits) and error of each */
+            std::vector<char>           done(ret.size());
+            std::vector<std::string>    identities(ret.size());
+            std::mutex                  done_mutex{};
+
+            /* Held by the one worker writing a snapshot, so the others carry on cracking meanwhile */
+            std::mutex                  save_mutex{};
+
+            if (p_Checkpoint) {
+                std::transform(ret.begin(), ret.end(), identities.begin(), [](const rep_key_report& e) { return detail::file_identity(e.file); });
+            }
+
+            /* Entries are only read once marked done, and never change after that, so the copy only needs done_mutex */
+            const auto snapshot = [&] {
+                const std::lock_guard<std::mutex>   lock{done_mutex};
+                std::string                         payload{};
+
+                detail::put_u64(payload, static_cast<uint64_t>(std::count(done.begin(), done.end(), 1)));
+
+                for (std::size_t index{}; index < ret.size(); index++) {
+                    if (!done[index]) {
+                        continue;
                     }
-                    XOR_byte_blocks[keysize_index].push_back(full_ct_Bin[ct_block_index + keysize_index]);
+
+                    const rep_key_report&   e{ret[index]};
+                    uint64_t                confidence{};
+
+                    std::memcpy(&confidence, &e.guess.confidence, sizeof(confidence));
+
+                    detail::put_bytes(payload, e.file);
+                    detail::put_bytes(payload, identities[index]);
+                    detail::put_u64(payload, e.size);
+                    detail::put_bytes(payload, std::string_view{reinterpret_cast<const char*>(e.guess.key.data()), e.guess.key.length()});
+                    detail::put_u64(payload, e.guess.score);
+                    detail::put_u64(payload, confidence);
+                    detail::put_bytes(payload, e.error);
                 }
-            }
 
-            for (std::size_t index{}; index < keysize; index++) {
-                key += std::get<2>(XOR_byte_dec<kim::sec::Binary>(XOR_byte_blocks[index]));
+                return payload;
+            };
+
+            if (std::string payload{}; p_Checkpoint && p_Checkpoint->load(checkpoint_kind::rep_key_corpus, "", payload)) {
+                std::string_view rest{payload};
+
+                for (uint64_t count{detail::get_u64(rest)}; count > 0; count--) {
+                    rep_key_report          saved{std::string{detail::get_bytes(rest)}};
+                    const std::string_view  identity{detail::get_bytes(rest)};
+
+                    saved.size = detail::get_u64(rest);
+
+                    const std::string_view key{detail::get_bytes(rest)};
+
+                    saved.guess.key = Binary{ByteView{reinterpret_cast<const std::byte*>(key.data()), key.length()}};
+                    saved.guess.score = detail::get_u64(rest);
+
+                    const uint64_t confidence{detail::get_u64(rest)};
+
+                    std::memcpy(&saved.guess.confidence, &confidence, sizeof(confidence));
+                    saved.error = detail::get_bytes(rest);
+
+                    /* Files no longer in the corpus are dropped, and files changed since are cracked again */
+                    const auto found{std::lower_bound(ret.begin(), ret.end(), saved,
+                                                      [](const rep_key_report& lhs, const rep_key_report& rhs) { return lhs.file < rhs.file; })};
+
+                    if (found != ret.end() && found->file == saved.file && !identity.empty()
+                        && identity == identities[static_cast<std::size_t>(found - ret.begin())]) {
+                        done[static_cast<std::size_t>(found - ret.begin())] = 1;
+                        *found = std::move(saved);
+                    }
+                }
             }
 
-            for (std::size_t ct_index{}, key_index{}; ct_index < full_ct_Bin_length; ct_index++, key_index++) {
-                if (key_index == keysize) {
-                    key_index = 0;
+            /* Largest first, the sizes being the file sizes until the files are decoded */
+            std::vector<std::size_t> order{};
+
+            for (std::size_t index{}; index < ret.size(); index++) {
+                /* Entries which could not even be listed keep their error */
+                if (!done[index] && ret[index].error.empty()) {
+                    order.push_back(index);
                 }
+            }
 
-                pt_Bin.push_back(key[key_index] ^ full_ct_Bin[ct_index]);
+            std::stable_sort(order.begin(), order.end(), [&](const std::size_t lhs, const std::size_t rhs) { return ret[lhs].size > ret[rhs].size; });
+
+            ThreadPool                          pool{p_threads};
+            std::atomic<std::size_t>            next_file{};
+            std::vector<std::future<void>>      workers{};
+
+            for (std::size_t id{}; id < std::min(pool.size(), order.size()); id++) {
+                workers.push_back(pool.submit([&] {
+                    Arena& arena{Arena::local()};
+
+                    for (std::size_t index{next_file.fetch_add(1)}; index < order.size(); index = next_file.fetch_add(1)) {
+                        rep_key_report& entry{ret[order[index]]};
+
+                        try {
+                            FileSource              source{entry.file};
+                            const std::string_view  text{source.joined_lines()};
+
+                            KIM_SEC_PROBE(probe::XOR_rep_key_dec, text.length());
+
+                            const Container         ct_Con{text, arena.resource()};
+                            const Binary            ct_Bin{ct_Con.to_Bin(arena.resource())};
+
+                            entry.size = ct_Bin.length();
+                            entry.guess = XOR_rep_key_crack(ct_Bin.view(), arena.resource());
+                        } catch (const std::exception& e) {
+                            entry.size = 0;
+                            entry.error = e.what();
+                        }
+
+                        arena.reset();
+
+                        {
+                            const std::lock_guard<std::mutex> lock{done_mutex};
+                            done[order[index]] = 1;
+                        }
+
+                        /* A worker finding another one saving skips this save rather than queueing behind its disk I/O */
+                        if (std::unique_lock<std::mutex> saving{save_mutex, std::try_to_lock}; saving && p_Checkpoint && p_Checkpoint->due()) {
+                            p_Checkpoint->save(checkpoint_kind::rep_key_corpus, "", snapshot());
+                        }
+                    }
+                }));
+            }
+
+            for (std::future<void>& e : workers) {
+                e.get();
             }
 
-            ret << pt_Bin.to_ASCII();
+            if (p_Checkpoint) {
+                p_Checkpoint->save(checkpoint_kind::rep_key_corpus, "", snapshot());
+            }
 
             return ret;
         }
+
+        /*
+         * @brief Decrypts a file containing XOR repeating key encrypted ciphertext
+         *
+         * @param Container Template parameter for the type of the ciphertext (kim::sec security type)
+         *
+         * @param p_Source The input file containing the ciphertext (kim::sec::FileSource)
+         * @param p_out_name The output file name (std::string)
+         *
+         * @return File with plaintext, open for appending (std::ofstream)
+         */
+        template <class Container>
+        std::ofstream XOR_rep_key_dec(FileSource p_Source, const std::string& p_out_name)
+        {
+            /* The writer thread overlaps the output with the decryption, the stream is only reopened for the caller */
+            {
+                FileSink sink{p_out_name};
+
+                XOR_rep_key_dec<Container>(std::move(p_Source), sink);
+                sink.close();
+            }
+
+            return std::ofstream{p_out_name, std::ios::app};
+        }
+
+        /*
+         * @brief Decrypts a file containing XOR repeating key encrypted ciphertext
+         *
+         * @param Container Template parameter for the type of the ciphertext (kim::sec security type)
+         *
+         * @param p_in_File The input file containing the ciphertext (std::ifstream)
+         * @param p_out_name The output file name (std::string)
+         *
+         * @return File with plaintext (std::ofstream)
+         */
+        template <class Container>
+        std::ofstream XOR_rep_key_dec(std::ifstream p_in_File, const std::string& p_out_name)
+        {
+            return XOR_rep_key_dec<Container>(FileSource{p_in_File}, p_out_name);
+        }
     }
 }
 
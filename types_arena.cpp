@@ -0,0 +1,34 @@
+/*
+ * @brief kim::sec::Arena Source File
+ * @author Edward Kim
+ */
+#include "types_arena.hpp"
+
+namespace kim
+{
+    namespace sec
+    {
+        Arena::Arena(const std::size_t p_initial_size)
+            : m_initial{std::make_unique<std::byte[]>(p_initial_size)},
+              m_resource{m_initial.get(), p_initial_size} { }
+
+        Arena::~Arena() { }
+
+        std::pmr::memory_resource* Arena::resource()
+        {
+            return &m_resource;
+        }
+
+        void Arena::reset()
+        {
+            m_resource.release();
+        }
+
+        Arena& Arena::local()
+        {
+            thread_local Arena arena{};
+
+            return arena;
+        }
+    }
+}
@@ -0,0 +1,66 @@
+/*
+ * @brief kim::sec::Arena Header File
+ * @author Edward Kim
+ */
+#ifndef TYPES_ARENA
+#define TYPES_ARENA
+
+#include <memory>
+#include <memory_resource>
+
+#include <cstddef>
+
+/* Arena Class Declaration */
+namespace kim
+{
+    namespace sec
+    {
+        /*
+         * Monotonic scratch arena for bulk jobs
+         * - Allocations are bump-pointer and are only freed all at once by reset()
+         * - Anything allocated from the arena must be destroyed before reset() is called
+         */
+        class Arena
+        {
+        public:
+            /*** Constructors/Destructor ***/
+
+            /* Constructor which takes in the size of the initial buffer in bytes */
+            explicit Arena(const std::size_t = 64 * 1024);
+
+            /* Arenas hand out pointers into their own buffer, so they can be neither copied nor moved */
+            Arena(const Arena&) = delete;
+            Arena& operator=(const Arena&) = delete;
+
+            /* Destructor */
+            ~Arena();
+
+
+            /*** Public Methods ***/
+
+            /* Returns the memory resource to construct kim::sec security types with */
+            std::pmr::memory_resource*  resource();
+
+            /* Frees everything allocated from the arena and rewinds to the initial buffer */
+            void                        reset();
+
+
+            /*** Static Methods ***/
+
+            /* Returns the calling thread's arena */
+            static Arena&               local();
+
+
+        private:
+            /*** Private Member Variables ***/
+
+            /* Initial buffer, reused after every reset */
+            std::unique_ptr<std::byte[]> m_initial;
+
+            /* Underlying Data Structure */
+            std::pmr::monotonic_buffer_resource m_resource;
+        };
+    }
+}
+
+#endif /* TYPES_ARENA */
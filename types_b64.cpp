@@ -5,6 +5,9 @@
 #include "types_b64.hpp"
 
 #include <stdexcept>
+#include <utility>
+#include <algorithm>
+#include <array>
 
 #include <cctype>
 #include <cstdint>
@@ -12,6 +15,8 @@
 
 #include "types_hex.hpp"
 #include "types_bin.hpp"
+#include "types_validate.hpp"
+#include "types_stats.hpp"
 
 namespace kim
 {
@@ -19,52 +24,99 @@ namespace kim
     {
         Base64::Base64() { }
 
-        Base64::Base64(std::string p_str)
-        {
-            /* Appends padding, if necessary */
-            while (p_str.length() % 4 != 0) {
-                p_str.push_back('=');
-                m_pad++;
+        Base64::Base64(std::pmr::memory_resource* p_resource) : m_b64{p_resource} { }
+
+        /* Base64 digits by value */
+        static constexpr char base64_table[] = { 'A', 'B', 'C', 'D', 'E', 'F', 'G',
+                                                 'H', 'I', 'J', 'K', 'L', 'M', 'N',
+                                                 'O', 'P', 'Q', 'R', 'S', 'T', 'U',
+                                                 'V', 'W', 'X', 'Y', 'Z', 'a', 'b',
+                                                 'c', 'd', 'e', 'f', 'g', 'h', 'i',
+                                                 'j', 'k', 'l', 'm', 'n', 'o', 'p',
+                                                 'q', 'r', 's', 't', 'u', 'v', 'w',
+                                                 'x', 'y', 'z', '0', '1', '2', '3',
+                                                 '4', '5', '6', '7', '8', '9', '+', '/' };
+
+        /* Base64 digit values by character (only valid digits are ever looked up) */
+        static constexpr std::array<uint8_t, 256> sextet_table{[] {
+            std::array<uint8_t, 256> ret{};
+
+            for (uint8_t index{}; index < 64; index++) {
+                ret[static_cast<unsigned char>(base64_table[index])] = index;
             }
 
-            const std::string::size_type p_str_len{p_str.length()};
+            return ret;
+        }()};
 
-            /* Checks if the string is valid Base64 */
-            for (std::string::size_type index{}; index < p_str_len; index++) {
-                const char curr{p_str[index]};
+        /* Encodes 1 to 3 bytes as 2 to 4 digits, without padding */
+        static inline void encode_group(const std::byte* p_bytes, const std::size_t p_count, std::pmr::string& p_out)
+        {
+            const uint32_t group{(std::to_integer<uint32_t>(p_bytes[0]) << 16)
+                                 | (p_count > 1 ? std::to_integer<uint32_t>(p_bytes[1]) << 8 : 0)
+                                 | (p_count > 2 ? std::to_integer<uint32_t>(p_bytes[2]) : 0)};
 
-                if (!isalnum(curr) && curr != '+' && curr != '/' && curr != '=') {
-                    throw std::invalid_argument(p_str + std::string(" is not a valid Base64 string"));
-                } else if (curr == '=' && index != p_str_len - 1 && index != p_str_len - 2) {
-                    throw std::invalid_argument(p_str + std::string(" is not a valid Base64 string "
-                                                "or it has improper usage of the padding character (=)"));
-                }
+            for (std::size_t index{}; index <= p_count; index++) {
+                p_out.push_back(base64_table[(group >> (18 - 6 * index)) & 0x3F]);
             }
+        }
 
-            /* Edge case check */
-            if (p_str[p_str_len - 2] == '=' && p_str[p_str_len - 1] != '=') {
-                throw std::invalid_argument(p_str + std::string(" has improper padding"));
+        /* Checks for valid Base64 digits followed by at most two padding characters, returning the number of digits
+         * - The message is only built on failure
+         */
+        static std::size_t check_b64(const std::string_view p_str)
+        {
+            std::size_t body_len{p_str.length()};
+
+            while (body_len > 0 && p_str[body_len - 1] == '=') {
+                body_len--;
             }
 
-            m_b64 = p_str;
-        }
+            if (p_str.length() - body_len > 2) {
+                throw std::invalid_argument(std::string("Base64 string has improper usage of the padding character (=) at offset ")
+                                            + std::to_string(body_len));
+            }
 
-        Base64::Base64(const Binary& p_Bin)
-        {
-            *this = p_Bin.to_B64();
+            const std::size_t bad_offset{detail::b64_find_invalid(p_str.data(), body_len)};
+
+            if (bad_offset == body_len) {
+                return body_len;
+            } else if (p_str[bad_offset] == '=') {
+                throw std::invalid_argument(std::string("Base64 string has improper usage of the padding character (=) at offset ")
+                                            + std::to_string(bad_offset));
+            } else {
+                throw std::invalid_argument(std::string("Base64 string contains an invalid character at offset ")
+                                            + std::to_string(bad_offset));
+            }
         }
 
-        Base64::Base64(const Base64& p_B64)
+        Base64::Base64(const std::string& p_str) : Base64{std::string_view{p_str}, std::pmr::get_default_resource()} { }
+
+        Base64::Base64(std::string_view p_str, std::pmr::memory_resource* p_resource) : m_b64{p_resource}
         {
-            this->m_b64 = p_B64.m_b64;
-            this->m_pad = p_B64.m_pad;
+            KIM_SEC_PROBE(probe::Base64_parse, p_str.length());
+
+            const std::size_t body_len{check_b64(p_str)};
+
+            /* A lone digit in the last group, or more padding than the last group needs */
+            if (body_len % 4 == 1 || p_str.length() - body_len > (4 - body_len % 4) % 4) {
+                throw std::invalid_argument(std::string("Base64 string has improper usage of the padding character (=) at offset ")
+                                            + std::to_string(body_len));
+            }
+
+            m_b64.assign(p_str.data(), body_len);
         }
 
+        Base64::Base64(const Binary& p_Bin) : Base64{p_Bin.to_B64()} { }
+
+        Base64::Base64(const Base64& p_B64) : m_b64{p_B64.m_b64} { }
+
+        Base64::Base64(Base64&& p_B64) noexcept : m_b64{std::move(p_B64.m_b64)} { }
+
         Base64::~Base64() { }
 
         std::size_t Base64::length() const
         {
-            return m_b64.length();
+            return m_b64.length() + pad();
         }
 
         bool Base64::empty() const
@@ -77,65 +129,66 @@ namespace kim
             m_b64.reserve(p_size);
         }
 
-        Base64& Base64::append(std::string p_str)
+        Base64& Base64::append(const std::string_view p_str)
         {
-            const std::string::size_type p_str_len{p_str.length()};
-
-            /* Checks if the string is valid Base64 */
-            for (std::string::size_type index{}; index < p_str.length(); index++) {
-                const char curr_chr{p_str[index]};
+            const std::size_t body_len{check_b64(p_str)};
 
-                if (!isalnum(curr_chr) && curr_chr != '+' && curr_chr != '/' && curr_chr != '=') {
-                    throw std::invalid_argument(p_str + std::string(" is not a valid Base64 string"));
-                } else if (curr_chr == '=' && index != p_str_len - 1 && index != p_str_len - 2) {
-                    throw std::invalid_argument(p_str + std::string(" has improper usage of the padding character (=)"));
-                }
+            /* String length divided by 4 cannot have a remainder of 1 */
+            if ((m_b64.length() + body_len) % 4 == 1) {
+                throw std::invalid_argument(std::string("Appending the string ")
+                                            + std::string{p_str} + std::string(" will lead to an invalid Base64 string"));
             }
 
-            /* Edge case check */
-            if (p_str[p_str_len - 2] == '=' && p_str[p_str_len - 1] != '=') {
-                throw std::invalid_argument(p_str + std::string(" has improper padding"));
+            /* Padding of either side is implied by the digit count, so the digits are simply concatenated */
+            m_b64.append(p_str.data(), body_len);
+
+            return *this;
+        }
+
+        Base64& Base64::append(const ByteView p_bytes)
+        {
+            if (p_bytes.empty()) {
+                return *this;
             }
 
-            /* Replace any original padding in the original Base64 string */
-            if (m_pad == 2 && !p_str.empty()) {
-                m_b64[m_b64.length() - 2] = p_str[0];
-                p_str.erase(0, 1);
-                m_pad--;
+            /* The 1 or 2 bytes of a trailing partial group are decoded out of its digits and carried into the new bytes */
+            const std::size_t   tail{m_b64.length() % 4};
+            std::byte           group[3]{};
+            std::size_t         carry{};
 
-                if (!p_str.empty()) {
-                    m_b64[m_b64.length() - 1] = p_str[1];
-                    p_str.erase(0, 1);
-                    m_pad--;
+            if (tail) {
+                uint32_t bits{};
+
+                for (std::size_t index{m_b64.length() - tail}; index < m_b64.length(); index++) {
+                    bits = (bits << 6) | sextet_table[static_cast<unsigned char>(m_b64[index])];
                 }
-            } else if (m_pad == 1 && !p_str.empty()) {
-                m_b64[p_str_len - 1] = p_str[0];
-                p_str.erase(0, 1);
-                m_pad--;
-            }
 
-            /* Append the remainder of the string to append */
-            if (!p_str.empty()) {
-                m_b64 += p_str;
+                bits <<= 6 * (4 - tail);
+                carry = tail - 1;
+                group[0] = static_cast<std::byte>(bits >> 16);
+                group[1] = static_cast<std::byte>(bits >> 8);
+                m_b64.resize(m_b64.length() - tail);
             }
 
-            /* Remove any padding */
-            if (m_b64[m_b64.length() - 2] == '=') {
-                m_b64.erase(m_b64.length() - 2);
-            } else if (m_b64[m_b64.length() - 1] == '=') {
-                m_b64.erase(m_b64.length() - 1);
+            const std::size_t   total{carry + p_bytes.length()};
+            std::size_t         index{};
+
+            m_b64.reserve(m_b64.length() + (total + 2) / 3 * 4);
+
+            if (carry) {
+                for (; carry + index < 3 && index < p_bytes.length(); index++) {
+                    group[carry + index] = p_bytes[index];
+                }
+
+                encode_group(group, carry + index, m_b64);
             }
 
-            /* String length divided by 4 cannot have a remainder of 1 */
-            if (m_b64.length() % 4 == 1) {
-                throw std::logic_error(std::string("Appending the string ")
-                                       + p_str + std::string(" will lead to an invalid Base64 string"));
+            for (; index + 3 <= p_bytes.length(); index += 3) {
+                encode_group(p_bytes.data() + index, 3, m_b64);
             }
 
-            /* Add any padding, if necessary */
-            while (m_b64.length() % 4 != 0) {
-                m_b64.push_back('=');
-                m_pad++;
+            if (index < p_bytes.length()) {
+                encode_group(p_bytes.data() + index, p_bytes.length() - index, m_b64);
             }
 
             return *this;
@@ -147,55 +200,58 @@ namespace kim
                 throw std::invalid_argument("Truncation size is not a multiple of 4");
             }
 
-            m_b64 = m_b64.substr(0, m_b64.length() - p_size);
+            /* Whole padded groups are removed, so only full groups remain */
+            const std::size_t padded_len{length()};
+
+            m_b64.resize(std::min(m_b64.length(), padded_len - std::min(p_size, padded_len)));
 
             return *this;
         }
 
+        uint8_t Base64::pad() const
+        {
+            return static_cast<uint8_t>((4 - m_b64.length() % 4) % 4);
+        }
+
         Binary Base64::to_Bin() const
         {
-            Binary ret{};
-            ret.reserve(m_b64.size() / 4 * 3);
-
-            for (std::string::size_type index{}; index < m_b64.length(); index += 4) {
-                uint8_t sextet[4] = { };
-
-                for (uint8_t sextet_index{}; sextet_index < 4; sextet_index++) {
-                    const char curr{m_b64[index + sextet_index]};
-
-                    if (isalpha(curr)) {
-                        if (isupper(curr)) {
-                            sextet[sextet_index] = curr - 'A';
-                        } else {
-                            sextet[sextet_index] = curr - 'a' + 26;
-                        }
-                    } else if (isdigit(curr)) {
-                        sextet[sextet_index] = curr - '0' + 52;
-                    } else {
-                        switch(curr) {
-                            case '+':
-                                sextet[sextet_index] = 62;
-                                break;
-                            case '/':
-                                sextet[sextet_index] = 63;
-                                break;
-                            default:
-                                sextet[sextet_index] = 64;
-                        }
-                    }
-                }
+            return to_Bin(resource());
+        }
+
+        Binary Base64::to_Bin(std::pmr::memory_resource* p_resource) const
+        {
+            KIM_SEC_PROBE(probe::Base64_to_Bin, m_b64.length());
+
+            Binary              ret{p_resource};
+            const std::size_t   full_len{m_b64.length() / 4 * 4};
+            std::size_t         index{};
+
+            ret.reserve(m_b64.length() * 3 / 4);
+
+            for (; index < full_len; index += 4) {
+                const uint32_t group{(uint32_t{sextet_table[static_cast<unsigned char>(m_b64[index])]} << 18)
+                                     | (uint32_t{sextet_table[static_cast<unsigned char>(m_b64[index + 1])]} << 12)
+                                     | (uint32_t{sextet_table[static_cast<unsigned char>(m_b64[index + 2])]} << 6)
+                                     | uint32_t{sextet_table[static_cast<unsigned char>(m_b64[index + 3])]}};
 
-                ret.push_back(static_cast<std::byte>(((sextet[0] & 0b00111111) << 2) + ((sextet[1] & 0b00110000) >> 4)));
+                ret.push_back(static_cast<std::byte>(group >> 16));
+                ret.push_back(static_cast<std::byte>(group >> 8));
+                ret.push_back(static_cast<std::byte>(group));
+            }
+
+            /* A trailing group of 2 or 3 digits holds 1 or 2 bytes */
+            if (index < m_b64.length()) {
+                uint32_t group{};
 
-                if (sextet[2] == 64) {
-                    continue;
+                for (std::size_t k{index}; k < m_b64.length(); k++) {
+                    group = (group << 6) | sextet_table[static_cast<unsigned char>(m_b64[k])];
                 }
-                ret.push_back(static_cast<std::byte>(((sextet[1] & 0b00001111) << 4) + ((sextet[2] & 0b00111100) >> 2)));
 
-                if (sextet[3] == 64) {
-                    continue;
+                group <<= 6 * (4 - (m_b64.length() - index));
+
+                for (std::size_t k{1}; k < m_b64.length() - index; k++) {
+                    ret.push_back(static_cast<std::byte>(group >> (24 - 8 * k)));
                 }
-                ret.push_back(static_cast<std::byte>(((sextet[2] & 0b00000011) << 6) + (sextet[3] & 0b00111111)));
             }
 
             return ret;
@@ -203,8 +259,10 @@ namespace kim
 
         Hex Base64::to_Hex() const
         {
+            KIM_SEC_PROBE(probe::Base64_to_Hex, m_b64.length());
+
             const Binary        this_Bin{this->to_Bin()};
-            std::string         append_str{};
+            std::pmr::string    append_str{resource()};
             const char          hex_table[] = { '0', '1', '2', '3',
                                                 '4', '5', '6', '7',
                                                 '8', '9', 'A', 'B',
@@ -217,24 +275,61 @@ namespace kim
                 append_str.push_back(hex_table[std::to_integer<uint8_t>(this_Bin[index] & std::byte{0b00001111})]);
             }
 
-            return Hex(append_str);
+            return Hex::from_valid(std::move(append_str));
+        }
+
+        Base64& Base64::operator=(const Base64& rhs)
+        {
+            m_b64 = rhs.m_b64;
+
+            return *this;
+        }
+
+        Base64& Base64::operator=(Base64&& rhs)
+        {
+            m_b64 = std::move(rhs.m_b64);
+
+            return *this;
+        }
+
+        std::pmr::memory_resource* Base64::resource() const
+        {
+            return m_b64.get_allocator().resource();
         }
 
         Base64& Base64::operator+=(const Base64& rhs)
         {
-            return this->append(rhs.m_b64);
+            if ((m_b64.length() + rhs.m_b64.length()) % 4 == 1) {
+                throw std::invalid_argument("Concatenating the Base64 strings will lead to an invalid Base64 string");
+            }
+
+            /* Appending a string to itself is well defined, unlike appending a view of it */
+            m_b64.append(rhs.m_b64);
+
+            return *this;
         }
 
-        Base64 Base64::operator+(const Base64& rhs)
+        Base64 Base64::operator+(const Base64& rhs) const &
         {
-            Base64 this_copy{*this};
+            if ((m_b64.length() + rhs.m_b64.length()) % 4 == 1) {
+                throw std::invalid_argument("Concatenating the Base64 strings will lead to an invalid Base64 string");
+            }
+
+            Base64 ret{resource()};
+            ret.m_b64.reserve(m_b64.length() + rhs.m_b64.length());
+            ret.m_b64.append(m_b64).append(rhs.m_b64);
 
-            return this_copy.append(rhs.m_b64);
+            return ret;
+        }
+
+        Base64 Base64::operator+(const Base64& rhs) &&
+        {
+            return std::move(*this += rhs);
         }
 
         std::ostream& operator<<(std::ostream& os, const Base64& p_B64)
         {
-            return os << p_B64.m_b64;
+            return os << p_B64.m_b64 << std::string_view{"==", p_B64.pad()};
         }
     }
 }
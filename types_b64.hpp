@@ -7,6 +7,9 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <memory_resource>
+#include <type_traits>
 
 /* Forward Declarations */
 namespace kim
@@ -15,6 +18,7 @@ namespace kim
     {
         class Hex;
         class Binary;
+        class ByteView;
     }
 }
 
@@ -31,15 +35,30 @@ namespace kim
             /* Empty Constructor */
             Base64();
 
+            /* Empty Constructor which allocates from the given memory resource */
+            explicit Base64(std::pmr::memory_resource*);
+
             /* Constructor which takes in a valid Base64 string with or without padding */
-            Base64(std::string);
+            Base64(const std::string&);
+
+            /* Constructor which takes in a valid Base64 std::string_view without an intermediate std::string
+             * - Constrained to exactly std::string_view so string literals still pick the std::string overload
+             */
+            template <class StringView, std::enable_if_t<std::is_same_v<StringView, std::string_view>, int> = 0>
+            Base64(const StringView& p_str) : Base64{p_str, std::pmr::get_default_resource()} { }
+
+            /* Constructor which takes in a valid Base64 string with or without padding and allocates from the given memory resource */
+            Base64(std::string_view, std::pmr::memory_resource*);
 
             /* Constructor which takes in a Binary object */
             Base64(const Binary&);
 
-            /* Copy Constructor */
+            /* Copy Constructor (the copy uses the default memory resource) */
             Base64(const Base64&);
 
+            /* Move Constructor */
+            Base64(Base64&&) noexcept;
+
             /* Destructor */
             ~Base64();
 
@@ -55,12 +74,18 @@ namespace kim
             /* Reserves space for the Base64 string specified by a size_t argument */
             void                reserve(const std::string::size_type);
 
-            /* Appends a string with valid Base64
+            /* Appends a string with valid Base64 digits
              * - Will replace any padding in the original Base64 string
              * - Padding in the string argument is optional but will throw an exception if
              *   resultant string is invalid Base64
              */
-            Base64&             append(std::string);
+            Base64&             append(const std::string_view);
+
+            /* Appends the encoding of bytes, continuing the bytes already encoded
+             * - Bits of a trailing partial group are carried into the new bytes, so building a
+             *   Base64 string from many small appends takes linear time
+             */
+            Base64&             append(const ByteView);
 
             /* Removes the specified number of Base64 digits from the back (must be a multiple of 4) */
             Base64&             discard(const std::string::size_type = 4);
@@ -68,27 +93,45 @@ namespace kim
             /* Returns the Binary object equivalent of the Base64 string */
             Binary              to_Bin() const;
 
+            /* Returns the Binary object equivalent of the Base64 string, allocated from the given memory resource */
+            Binary              to_Bin(std::pmr::memory_resource*) const;
+
+            /* Returns the memory resource used by the Base64 string */
+            std::pmr::memory_resource*  resource() const;
+
             /* Returns the Hexadecimal object equivalent of the Base64 string */
             Hex                 to_Hex() const;
 
 
             /*** Operators ***/
 
+            /* Copy Assignment Operator */
+            Base64&             operator=(const Base64&);
+
+            /* Move Assignment Operator (copies if the memory resources differ) */
+            Base64&             operator=(Base64&&);
+
             /* Appends another Base64 object */
             Base64&             operator+=(const Base64&);
 
             /* Returns the concatenation of two Base64 objects */
-            Base64              operator+(const Base64&);
+            Base64              operator+(const Base64&) const &;
+
+            /* Returns the concatenation of two Base64 objects, reusing the buffer of an rvalue lhs */
+            Base64              operator+(const Base64&) &&;
 
 
         private:
-            /*** Private Member Variables ***/
+            /*** Private Methods ***/
+
+            /* Returns the number of padding characters the digits need to fill their last group */
+            uint8_t             pad() const;
 
-            /* Underlying Data Structure */
-            std::string m_b64;
 
-            /* Padding count */
-            uint8_t m_pad;
+            /*** Private Member Variables ***/
+
+            /* Underlying Data Structure, the digits without padding (never 1 more than a multiple of 4) */
+            std::pmr::string m_b64;
 
 
         /*** Friends ***/
@@ -4,11 +4,15 @@
  */
 #include "types_bin.hpp"
 
-#include <bitset>
 #include <algorithm>
+#include <functional>
+#include <utility>
 
 #include "types_hex.hpp"
 #include "types_b64.hpp"
+#include "types_validate.hpp"
+#include "types_format.hpp"
+#include "types_stats.hpp"
 
 namespace kim
 {
@@ -16,129 +20,150 @@ namespace kim
     {
         Binary::Binary() { }
 
-        Binary::Binary(std::string p_str)
-        {
-            if (p_str.empty()) {
-                return;
-            }
+        Binary::Binary(std::pmr::memory_resource* p_resource) : m_resource{p_resource} { }
 
-            for (const char& e : p_str) {
-                /* Check if the string argument is an ASCII string */
-                if (e != '0' && e != '1' && e != ' ') {
-                    m_bin.reserve(p_str.length());
+        Binary::Binary(const std::string& p_str) : Binary{std::string_view{p_str}, std::pmr::get_default_resource()} { }
+
+        Binary::Binary(const std::string_view p_str, std::pmr::memory_resource* p_resource) : m_resource{p_resource}
+        {
+            std::size_t bits{};
 
-                    for (const char &e : p_str) {
-                        if (!isascii(e)) {
-                            throw std::invalid_argument("String contains a non-ASCII character");
-                        } else {
-                            m_bin.push_back(static_cast<std::byte>(e));
-                        }
-                    }
+            /* The destructor does not run if a constructor throws, so the buffer reserved here is released by hand */
+            try {
+                reserve(p_str.length() / 8);
 
+                /* Any character other than a bit or whitespace makes the whole string ASCII */
+                if (detail::bits_pack(p_str.data(), p_str.length(), m_data, bits) != p_str.length()) {
+                    assign_ascii(p_str);
                     return;
                 }
-            }
-
-            /* Remove any spaces */
-            p_str.erase(std::remove(p_str.begin(), p_str.end(), ' '), p_str.end());
 
-            /* String length must be a multiple of 8 */
-            if (p_str.length() % 8 != 0) {
-                throw std::invalid_argument(std::string("The length of the string ")
-                                            + p_str + std::string(" is not a multiple of 8"));
+                /* String length must be a multiple of 8 */
+                if (bits % 8 != 0) {
+                    throw std::invalid_argument(std::string("The length of the string ")
+                                                + std::string{p_str} + std::string(" is not a multiple of 8"));
+                }
+            } catch (...) {
+                release();
+                throw;
             }
 
-            m_bin.reserve(p_str.length() / 8);
-
-            /* Check if the string is a valid binary string */
-            for (std::string::size_type byte_index{}; byte_index < p_str.length(); byte_index += 8) {
-                for (uint8_t bit_index{}; bit_index < 8; bit_index++) {
-                    if ((p_str[byte_index + bit_index] != '0') && (p_str[byte_index + bit_index] != '1')) {
-                        throw std::invalid_argument(p_str + std::string(" is not a valid Binary string"));
-                    }
-                }
+            m_size = bits / 8;
+        }
 
-                m_bin.push_back(static_cast<std::byte>(std::stoi(p_str.substr(byte_index, 8), nullptr, 2)));
-            }
+        Binary::Binary(ascii_t, const std::string_view p_str)
+        {
+            assign_ascii(p_str);
         }
 
-        Binary::Binary(const std::vector<std::byte>& p_vec) : m_bin{p_vec} { }
+        Binary::Binary(const std::vector<std::byte>& p_vec) : Binary{ByteView{p_vec.data(), p_vec.size()}} { }
 
-        Binary::Binary(const std::byte& p_byte) : m_bin{p_byte} { }
+        Binary::Binary(const ByteView& p_view)
+        {
+            assign(p_view.data(), p_view.length());
+        }
 
-        Binary::Binary(const Hex& p_Hex)
+        Binary::Binary(const ByteView& p_view, std::pmr::memory_resource* p_resource) : m_resource{p_resource}
         {
-            *this = p_Hex.to_Bin();
+            assign(p_view.data(), p_view.length());
         }
 
-        Binary::Binary(const Base64& p_B64)
+        Binary::Binary(const std::byte& p_byte)
         {
-            *this = p_B64.to_Bin();
+            m_inline[0] = p_byte;
+            m_size = 1;
         }
 
+        Binary::Binary(const Hex& p_Hex) : Binary{p_Hex.to_Bin()} { }
+
+        Binary::Binary(const Base64& p_B64) : Binary{p_B64.to_Bin()} { }
+
         Binary::Binary(const Binary& p_Bin)
         {
-            this->m_bin = p_Bin.m_bin;
+            assign(p_Bin.m_data, p_Bin.m_size);
+        }
+
+        Binary::Binary(Binary&& p_Bin) noexcept : m_resource{p_Bin.m_resource}
+        {
+            steal(p_Bin);
         }
 
-        Binary::~Binary() { }
+        Binary::~Binary()
+        {
+            release();
+        }
 
         std::size_t Binary::length() const
         {
-            return m_bin.size();
+            return m_size;
         }
 
         bool Binary::empty() const
         {
-            return m_bin.empty();
+            return m_size == 0;
         }
 
         void Binary::push_back(const std::byte& p_byte)
         {
-            m_bin.push_back(p_byte);
+            if (m_size == m_capacity) {
+                grow(m_capacity * 2);
+            }
+
+            m_data[m_size++] = p_byte;
         }
 
         void Binary::pop_back(const std::vector<std::byte>::size_type p_size)
         {
-            m_bin.reserve(m_bin.size() - p_size);
-
-            for (std::vector<std::byte>::size_type count{p_size}; count > 0; count--) {
-                m_bin.pop_back();
-            }
+            m_size -= std::min<std::size_t>(p_size, m_size);
         }
 
         void Binary::reserve(const std::vector<std::byte>::size_type p_size)
         {
-            m_bin.reserve(p_size);
+            if (p_size > m_capacity) {
+                grow(p_size);
+            }
         }
 
-        Binary& Binary::append(std::string p_str)
+        Binary& Binary::pkcs7_pad(const std::size_t p_block_size)
         {
-            if (p_str.empty()) {
-                return *this;
+            if (p_block_size == 0 || p_block_size > 255) {
+                throw std::invalid_argument("PKCS#7 block size is not from 1 to 255");
             }
 
-            /* Remove any spaces */
-            p_str.erase(std::remove(p_str.begin(), p_str.end(), ' '), p_str.end());
+            const std::size_t pad{p_block_size - m_size % p_block_size};
+
+            reserve(m_size + pad);
+            std::fill_n(m_data + m_size, pad, static_cast<std::byte>(pad));
+            m_size += pad;
 
-            m_bin.reserve(m_bin.size() + p_str.length() / 8);
+            return *this;
+        }
+
+        Binary& Binary::pkcs7_unpad(const std::size_t p_block_size)
+        {
+            m_size = view().pkcs7_unpad(p_block_size).length();
+
+            return *this;
+        }
+
+        Binary& Binary::append(const std::string_view p_str)
+        {
+            std::size_t bits{};
+
+            reserve(m_size + p_str.length() / 8);
+
+            /* Bytes are packed past m_size, so the Binary string is unchanged if the string is invalid */
+            if (detail::bits_pack(p_str.data(), p_str.length(), m_data + m_size, bits) != p_str.length()) {
+                throw std::invalid_argument(std::string{p_str} + std::string(" is not a valid Binary string"));
+            }
 
             /* String length must be a multiple of 8 */
-            if (p_str.length() % 8 != 0) {
+            if (bits % 8 != 0) {
                 throw std::invalid_argument(std::string("The length of the string ")
-                                            + p_str + std::string(" is not a multiple of 8"));
+                                            + std::string{p_str} + std::string(" is not a multiple of 8"));
             }
 
-            /* Check if the string is a valid binary string */
-            for (std::string::size_type byte_index{}; byte_index < p_str.length(); byte_index += 8) {
-                for (uint8_t bit_index{}; bit_index < 8; bit_index++) {
-                    if ((p_str[byte_index + bit_index] != '0') && (p_str[byte_index + bit_index] != '1')) {
-                        throw std::invalid_argument(p_str + std::string(" is not a valid Binary string"));
-                    }
-                }
-
-                m_bin.push_back(static_cast<std::byte>(std::stoi(p_str.substr(byte_index, 8), nullptr, 2)));
-            }
+            m_size += bits / 8;
 
             return *this;
         }
@@ -149,153 +174,221 @@ namespace kim
                 throw std::invalid_argument("Length of sub Binary object is invalid");
             }
 
-            return Binary(std::vector<std::byte>(m_bin.begin() + p_index, m_bin.begin() + p_index + p_len));
+            return Binary{subview(p_index, p_len)};
+        }
+
+        ByteView Binary::view() const
+        {
+            return ByteView{m_data, m_size};
+        }
+
+        ByteView Binary::subview(const std::vector<std::byte>::size_type p_index, const std::vector<std::byte>::size_type p_len) const
+        {
+            return view().subview(p_index, p_len);
+        }
+
+        const std::byte* Binary::data() const
+        {
+            return m_data;
+        }
+
+        std::byte* Binary::data()
+        {
+            return m_data;
+        }
+
+        std::pmr::memory_resource* Binary::resource() const
+        {
+            return m_resource;
         }
 
         Hex Binary::to_Hex() const
         {
-            std::string     ret_str{};
-            const char      hex_table[] = { '0', '1', '2', '3',
-                                            '4', '5', '6', '7',
-                                            '8', '9', 'A', 'B',
-                                            'C', 'D', 'E', 'F' };
+            KIM_SEC_PROBE(probe::Binary_to_Hex, m_size);
 
-            ret_str.reserve(m_bin.size() * 2);
+            std::pmr::string    ret_str{m_resource};
+            const char          hex_table[] = { '0', '1', '2', '3',
+                                                '4', '5', '6', '7',
+                                                '8', '9', 'A', 'B',
+                                                'C', 'D', 'E', 'F' };
 
-            for (std::vector<std::byte>::const_iterator it = m_bin.begin(); it != m_bin.end(); it++) {
-                ret_str.push_back(hex_table[std::to_integer<uint8_t>((*it & std::byte{0b11110000}) >> 4)]);
-                ret_str.push_back(hex_table[std::to_integer<uint8_t>(*it & std::byte{0b00001111})]);
+            ret_str.reserve(m_size * 2);
+
+            for (const std::byte& e : view()) {
+                ret_str.push_back(hex_table[std::to_integer<uint8_t>((e & std::byte{0b11110000}) >> 4)]);
+                ret_str.push_back(hex_table[std::to_integer<uint8_t>(e & std::byte{0b00001111})]);
             }
 
-            return Hex(ret_str);
+            return Hex::from_valid(std::move(ret_str));
         }
 
         Base64 Binary::to_B64() const
         {
-            Base64 ret{};
-            ret.reserve(m_bin.size() * 4 / 3 + (m_bin.size() * 4 % 3));
-
-            std::size_t index{};
-            const char base64_table[] = { 'A', 'B', 'C', 'D', 'E', 'F', 'G',
-                                          'H', 'I', 'J', 'K', 'L', 'M', 'N',
-                                          'O', 'P', 'Q', 'R', 'S', 'T', 'U',
-                                          'V', 'W', 'X', 'Y', 'Z', 'a', 'b',
-                                          'c', 'd', 'e', 'f', 'g', 'h', 'i',
-                                          'j', 'k', 'l', 'm', 'n', 'o', 'p',
-                                          'q', 'r', 's', 't', 'u', 'v', 'w',
-                                          'x', 'y', 'z', '0', '1', '2', '3',
-                                          '4', '5', '6', '7', '8', '9', '+', '/' };
-
-            /* Loop through every 3 bytes of the binary representation of the hexadecimal
-               string but only until the set that does not need padding */
-            for (; index < (m_bin.size() / 3) * 3; index += 3) {
-                std::string tmp_str{};
-
-                tmp_str.push_back(base64_table[std::to_integer<uint8_t>(m_bin[index] >> 2)]);
-                tmp_str.push_back(base64_table[std::to_integer<uint8_t>((m_bin[index] & std::byte{0b00000011}) << 4)
-                                             + std::to_integer<uint8_t>(m_bin[index + 1] >> 4)]);
-                tmp_str.push_back(base64_table[std::to_integer<uint8_t>((m_bin[index + 1] & std::byte{0b00001111}) << 2)
-                                             + std::to_integer<uint8_t>(m_bin[index + 2] >> 6)]);
-                tmp_str.push_back(base64_table[std::to_integer<uint8_t>(m_bin[index + 2] & std::byte{0b00111111})]);
-
-                ret.append(tmp_str);
-            }
+            KIM_SEC_PROBE(probe::Binary_to_B64, m_size);
 
-            /* If there are any remaining bytes, compute those and add padding */
-            const unsigned long     remaining{m_bin.size() % 3};
-            std::string             tmp_str{};
-
-            if (remaining == 1) {
-                tmp_str.push_back(base64_table[std::to_integer<uint8_t>(m_bin[index] >> 2)]);
-                tmp_str.push_back(base64_table[std::to_integer<uint8_t>((m_bin[index] & std::byte{0b00000011}) << 4)]);
-                tmp_str.append("==");
-            } else if (remaining == 2) {
-                tmp_str.push_back(base64_table[std::to_integer<uint8_t>(m_bin[index] >> 2)]);
-                tmp_str.push_back(base64_table[std::to_integer<uint8_t>((m_bin[index] & std::byte{0b00000011}) << 4)
-                                             + std::to_integer<uint8_t>(m_bin[index + 1] >> 4)]);
-                tmp_str.push_back(base64_table[std::to_integer<uint8_t>((m_bin[index + 1] & std::byte{0b00001111}) << 2)]);
-                tmp_str.push_back('=');
-            }
+            Base64 ret{m_resource};
 
-            ret.append(tmp_str);
+            ret.append(view());
 
             return ret;
         }
 
-        std::string Binary::to_ASCII()
-        {
-            std::string     ret{};
-            const char      *nonprint_ASCII[] = { "(NUL)", "(SOH)", "(STX)", "(ETX)", "(EOT)",
-                                                  "(ENQ)", "(ACK)", "(BEL)",  "(BS)",  "(HT)",
-                                                   "(LF)",  "(VT)",  "(FF)",  "(CR)",  "(SO)",
-                                                   "(SI)", "(DLE)", "(DC1)", "(DC2)", "(DC3)",
-                                                  "(DC4)", "(NAK)", "(SYN)", "(ETB)", "(CAN)",
-                                                   "(EM)", "(SUB)", "(ESC)",  "(FS)",  "(GS)",
-                                                   "(RS)",  "(US)" };
-
-            for (const std::byte& e : m_bin) {
-                uint8_t byte_int{std::to_integer<uint8_t>(e)};
-
-                if (byte_int > 127U) {
-                    return "";
-                } else if (byte_int >= 0U && byte_int <= 31U) {
-                    if (byte_int == 10U) {
-                        ret += "\n";
-                    } else {
-                        ret += nonprint_ASCII[byte_int];
-                    }
-                } else if (byte_int == 127U) {
-                    ret += "(DEL)";
-                } else {
-                    ret += (static_cast<char>(byte_int));
-                }
-            }
+        Binary Binary::to_Bin(std::pmr::memory_resource* p_resource) const
+        {
+            return Binary{view(), p_resource};
+        }
 
-            return ret;
+        std::string Binary::to_ASCII() const
+        {
+            return format_ascii(view());
         }
 
         std::byte Binary::operator[](const std::vector<std::byte>::size_type p_index) const
         {
-            return m_bin[p_index];
+            return m_data[p_index];
         }
 
         std::byte& Binary::operator[](const std::vector<std::byte>::size_type p_index)
         {
-            return m_bin[p_index];
+            return m_data[p_index];
         }
 
-        Binary& Binary::operator+=(const Binary& rhs)
+        Binary& Binary::operator=(const Binary& rhs)
+        {
+            if (this != &rhs) {
+                m_size = 0;
+                assign(rhs.m_data, rhs.m_size);
+            }
+
+            return *this;
+        }
+
+        Binary& Binary::operator=(Binary&& rhs)
         {
-            this->m_bin.reserve(m_bin.size() + rhs.m_bin.size());
+            if (this == &rhs) {
+                return *this;
+            }
 
-            for (auto& e: rhs.m_bin) {
-                this->m_bin.push_back(e);
+            /* Buffers can only change hands between equal memory resources */
+            if (m_resource == rhs.m_resource || m_resource->is_equal(*rhs.m_resource)) {
+                release();
+                steal(rhs);
+            } else {
+                m_size = 0;
+                assign(rhs.m_data, rhs.m_size);
             }
 
             return *this;
         }
 
-        Binary Binary::operator+(const Binary& rhs)
+        Binary& Binary::operator+=(const Binary& rhs)
+        {
+            const std::size_t rhs_size{rhs.m_size};
+
+            /* Reserve first and read rhs.m_data afterwards so that appending a Binary object to itself stays valid */
+            reserve(m_size + rhs_size);
+            std::copy_n(rhs.m_data, rhs_size, m_data + m_size);
+            m_size += rhs_size;
+
+            return *this;
+        }
+
+        Binary& Binary::operator+=(const ByteView rhs)
+        {
+            const std::size_t   rhs_size{rhs.length()};
+            const bool          inside{!std::less<const std::byte*>{}(rhs.data(), m_data) && std::less<const std::byte*>{}(rhs.data(), m_data + m_size)};
+            const std::size_t   offset{inside ? static_cast<std::size_t>(rhs.data() - m_data) : 0};
+
+            /* A view of this Binary object moves with its buffer if reserve() reallocates */
+            reserve(m_size + rhs_size);
+            std::copy_n(inside ? m_data + offset : rhs.data(), rhs_size, m_data + m_size);
+            m_size += rhs_size;
+
+            return *this;
+        }
+
+        Binary Binary::operator+(const Binary& rhs) const &
+        {
+            Binary ret{m_resource};
+            ret.reserve(m_size + rhs.m_size);
+            ret += *this;
+            ret += rhs;
+
+            return ret;
+        }
+
+        Binary Binary::operator+(const Binary& rhs) &&
         {
-            Binary this_copy{*this};
-            this_copy.m_bin.reserve(this_copy.m_bin.size() + rhs.m_bin.size());
+            *this += rhs;
+
+            return std::move(*this);
+        }
 
-            for (auto& e : rhs.m_bin) {
-                this_copy.push_back(e);
+        void Binary::grow(std::size_t p_capacity)
+        {
+            p_capacity = std::max(p_capacity, inline_capacity);
+
+            KIM_SEC_COUNT_BIN_ALLOC();
+
+            std::byte* const new_data{static_cast<std::byte*>(m_resource->allocate(p_capacity, alignof(std::max_align_t)))};
+            std::copy_n(m_data, m_size, new_data);
+
+            if (m_data != m_inline) {
+                m_resource->deallocate(m_data, m_capacity, alignof(std::max_align_t));
             }
 
-            return this_copy;
+            m_data = new_data;
+            m_capacity = p_capacity;
         }
 
-        std::ostream& operator<<(std::ostream& os, const Binary& p_Bin)
+        void Binary::assign(const std::byte* const p_data, const std::size_t p_size)
+        {
+            reserve(p_size);
+            std::copy_n(p_data, p_size, m_data);
+            m_size = p_size;
+        }
+
+        void Binary::assign_ascii(const std::string_view p_str)
         {
-            std::cout << std::bitset<8>(std::to_integer<uint8_t>(p_Bin.m_bin[0]));
+            if (std::any_of(p_str.begin(), p_str.end(), [](const char e) { return (e & 0x80) != 0; })) {
+                throw std::invalid_argument("String contains a non-ASCII character");
+            }
+
+            assign(reinterpret_cast<const std::byte*>(p_str.data()), p_str.length());
+        }
 
-            for (std::vector<std::byte>::const_iterator it = ++p_Bin.m_bin.begin(); it != p_Bin.m_bin.end(); it++) {
-                os << " " << std::bitset<8>(std::to_integer<uint8_t>(*it));
+        void Binary::steal(Binary& p_Bin) noexcept
+        {
+            if (p_Bin.m_data == p_Bin.m_inline) {
+                std::copy_n(p_Bin.m_inline, p_Bin.m_size, m_inline);
+                m_data = m_inline;
+                m_capacity = inline_capacity;
+            } else {
+                m_data = p_Bin.m_data;
+                m_capacity = p_Bin.m_capacity;
             }
 
-            return os;
+            m_size = p_Bin.m_size;
+
+            p_Bin.m_data = p_Bin.m_inline;
+            p_Bin.m_size = 0;
+            p_Bin.m_capacity = inline_capacity;
+        }
+
+        void Binary::release() noexcept
+        {
+            if (m_data != m_inline) {
+                m_resource->deallocate(m_data, m_capacity, alignof(std::max_align_t));
+            }
+
+            m_data = m_inline;
+            m_size = 0;
+            m_capacity = inline_capacity;
+        }
+
+        std::ostream& operator<<(std::ostream& os, const Binary& p_Bin)
+        {
+            return write_bits(os, p_Bin.view());
         }
     }
 }
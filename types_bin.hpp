@@ -8,10 +8,14 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <memory_resource>
 
 #include <cstdint>
 #include <cstddef>
 
+#include "types_view.hpp"
+
 /* Forward Declarations */
 namespace kim
 {
@@ -27,6 +31,14 @@ namespace kim
 {
     namespace sec
     {
+        /* Tag selecting the Binary constructor which takes a string as ASCII bytes, never as 1s and 0s */
+        struct ascii_t
+        {
+            explicit ascii_t() = default;
+        };
+
+        inline constexpr ascii_t ascii{};
+
         class Binary
         {
         public:
@@ -35,15 +47,30 @@ namespace kim
             /* Empty Constructor */
             Binary();
 
+            /* Empty Constructor which allocates any heap buffer from the given memory resource */
+            explicit Binary(std::pmr::memory_resource*);
+
             /* Constructor which takes in a
-             * - valid Binary string consisting of 1s and 0s (spaces are optional)
-             * - OR a valid ASCII string
+             * - valid Binary string consisting of 1s and 0s (spaces, tabs and newlines are skipped)
+             * - OR a valid ASCII string, if any other character appears
              */
-            Binary(std::string);
+            Binary(const std::string&);
+
+            /* Constructor which takes in a Binary or ASCII string as above and allocates from the given memory resource */
+            Binary(const std::string_view, std::pmr::memory_resource*);
+
+            /* Constructor which takes in a valid ASCII string as bytes (e.g. Binary{kim::sec::ascii, "0110"} is 4 bytes) */
+            Binary(ascii_t, const std::string_view);
 
             /* Constructor which takes in a vector of bytes */
             Binary(const std::vector<std::byte>&);
 
+            /* Constructor which copies the bytes of a ByteView */
+            explicit Binary(const ByteView&);
+
+            /* Constructor which copies the bytes of a ByteView into the given memory resource */
+            Binary(const ByteView&, std::pmr::memory_resource*);
+
             /* Constructor which takes in a single byte */
             Binary(const std::byte&);
 
@@ -53,9 +80,12 @@ namespace kim
             /* Constructor which takes in a Base64 object */
             Binary(const Base64&);
 
-            /* Copy Constructor */
+            /* Copy Constructor (the copy uses the default memory resource) */
             Binary(const Binary&);
 
+            /* Move Constructor */
+            Binary(Binary&&) noexcept;
+
             /* Destructor */
             ~Binary();
 
@@ -77,8 +107,16 @@ namespace kim
             /* Reserves space for the Binary string specified by a size_t argument */
             void                reserve(const std::vector<std::byte>::size_type);
 
-            /* Appends a valid Binary string (spaces are optional) */
-            Binary&             append(std::string);
+            /* Appends PKCS#7 padding in place up to a multiple of the block size (1-255, default 16) */
+            Binary&             pkcs7_pad(const std::size_t = 16);
+
+            /* Removes PKCS#7 padding in place by shortening the Binary string
+             * - The padding is validated in constant time, throwing std::invalid_argument if it is invalid
+             */
+            Binary&             pkcs7_unpad(const std::size_t = 16);
+
+            /* Appends a valid Binary string (spaces, tabs and newlines are skipped) */
+            Binary&             append(const std::string_view);
 
             /* Returns a part of the Binary object
              * - First argument is the index
@@ -86,20 +124,47 @@ namespace kim
              */
             Binary              subBin(const std::vector<std::byte>::size_type, const std::vector<std::byte>::size_type);
 
+            /* Returns a non-owning view of the whole Binary object */
+            ByteView            view() const;
+
+            /* Returns a non-owning view of a part of the Binary object without copying
+             * - First argument is the index
+             * - Second argument is the length (clamped to the end of the Binary object)
+             */
+            ByteView            subview(const std::vector<std::byte>::size_type, const std::vector<std::byte>::size_type) const;
+
+            /* Returns a pointer to the first byte */
+            const std::byte*    data() const;
+
+            /* Returns a pointer to the first byte, for writing in place */
+            std::byte*          data();
+
+            /* Returns the memory resource used for heap buffers */
+            std::pmr::memory_resource*  resource() const;
+
             /* Returns the Hexadecimal object equivalent of the Binary string */
             Hex                 to_Hex() const;
 
             /* Returns the Base64 object equivalent of the Binary string */
             Base64              to_B64() const;
 
+            /* Returns a copy of the Binary object allocated from the given memory resource */
+            Binary              to_Bin(std::pmr::memory_resource*) const;
+
             /* Returns the ASCII string equivalent of the Binary object
              * - If the string contains invalid ASCII, the method will return an empty string
              */
-            std::string         to_ASCII();
+            std::string         to_ASCII() const;
 
 
             /*** Public Member Operators ***/
 
+            /* Copy Assignment Operator */
+            Binary&             operator=(const Binary&);
+
+            /* Move Assignment Operator (copies if the memory resources differ) */
+            Binary&             operator=(Binary&&);
+
             /* Constant subscript operator */
             std::byte           operator[](const std::vector<std::byte>::size_type p_index) const;
 
@@ -109,15 +174,50 @@ namespace kim
             /* Appends another Binary object */
             Binary&             operator+=(const Binary&);
 
+            /* Appends bytes, which may be a view of this Binary object */
+            Binary&             operator+=(const ByteView);
+
             /* Returns the concatenation of two Binary objects */
-            Binary              operator+(const Binary&);
+            Binary              operator+(const Binary&) const &;
+
+            /* Returns the concatenation of two Binary objects, reusing the buffer of an rvalue lhs */
+            Binary              operator+(const Binary&) &&;
 
 
         private:
+            /*** Private Methods ***/
+
+            /* Moves the bytes to a heap buffer of (at least) the specified capacity */
+            void                grow(std::size_t);
+
+            /* Replaces the contents with a copy of the given bytes */
+            void                assign(const std::byte*, const std::size_t);
+
+            /* Replaces the contents with the bytes of an ASCII string, throwing if a character is not ASCII */
+            void                assign_ascii(const std::string_view);
+
+            /* Takes the buffer of another Binary object, leaving it empty */
+            void                steal(Binary&) noexcept;
+
+            /* Frees any heap buffer and returns to the empty inline buffer */
+            void                release() noexcept;
+
+
             /*** Private Member Variables ***/
 
-            /* Underlying Data Structure */
-            std::vector<std::byte> m_bin;
+            /* Number of bytes stored inline before spilling to the heap
+             * - Covers single bytes, AES blocks and common key sizes
+             */
+            static constexpr std::size_t inline_capacity{64};
+
+            /* Underlying Data Structure: m_data points either at m_inline or at a heap buffer */
+            std::byte*      m_data{m_inline};
+            std::size_t     m_size{};
+            std::size_t     m_capacity{inline_capacity};
+            std::byte       m_inline[inline_capacity];
+
+            /* Memory resource for heap buffers */
+            std::pmr::memory_resource* m_resource{std::pmr::get_default_resource()};
 
         /*** Friends ***/
 
@@ -0,0 +1,247 @@
+/*
+ * @brief kim::sec::Checkpoint Source File
+ * @author Edward Kim
+ */
+#include "types_checkpoint.hpp"
+
+#include <stdexcept>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <utility>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace kim
+{
+    namespace sec
+    {
+        static constexpr std::string_view   checkpoint_magic{"KSCP"};
+        static constexpr uint8_t            checkpoint_version{2};
+
+        /* Magic, version and kind */
+        static constexpr std::size_t        checkpoint_header{checkpoint_magic.length() + 2};
+
+        static uint64_t fnv1a(const std::string_view p_data)
+        {
+            uint64_t ret{0xCBF29CE484222325ULL};
+
+            for (const char e : p_data) {
+                ret = (ret ^ static_cast<uint8_t>(e)) * 0x100000001B3ULL;
+            }
+
+            return ret;
+        }
+
+        Checkpoint::Checkpoint(std::string p_file_name, const std::chrono::duration<double> p_interval)
+            : m_file_name{std::move(p_file_name)}, m_interval{p_interval} { }
+
+        const std::string& Checkpoint::file_name() const
+        {
+            return m_file_name;
+        }
+
+        bool Checkpoint::load(const checkpoint_kind p_kind, const std::string_view p_identity, std::string& p_payload) const
+        {
+            std::ifstream in_File{m_file_name, std::ios::binary};
+
+            if (!in_File) {
+                return false;
+            }
+
+            const std::string   contents{std::istreambuf_iterator<char>{in_File}, std::istreambuf_iterator<char>{}};
+            std::string_view    rest{contents};
+
+            /* Header, identity length, payload length and sum */
+            if (contents.length() < checkpoint_header + 8 + 8 + 8 || rest.substr(0, checkpoint_magic.length()) != checkpoint_magic) {
+                throw std::runtime_error(m_file_name + " is not a checkpoint");
+            }
+
+            rest.remove_prefix(checkpoint_magic.length());
+
+            if (static_cast<uint8_t>(rest[0]) != checkpoint_version) {
+                throw std::runtime_error(m_file_name + " is a checkpoint of another version");
+            }
+
+            const checkpoint_kind kind{static_cast<checkpoint_kind>(rest[1])};
+
+            rest.remove_prefix(2);
+
+            const std::string_view  identity{detail::get_bytes(rest)};
+            const uint64_t          length{detail::get_u64(rest)};
+
+            if (rest.length() < 8 || length != rest.length() - 8) {
+                throw std::runtime_error(m_file_name + " is a truncated checkpoint");
+            }
+
+            std::string_view sum{rest.substr(length)};
+
+            if (detail::get_u64(sum) != fnv1a(std::string_view{contents}.substr(0, contents.length() - 8))) {
+                throw std::runtime_error(m_file_name + " is a corrupt checkpoint");
+            }
+
+            if (kind != p_kind) {
+                return false;
+            }
+
+            if (identity != p_identity) {
+                throw std::runtime_error(m_file_name + " is a checkpoint of another input (" + std::string{identity}
+                                         + "), delete it to start over");
+            }
+
+            p_payload.assign(rest.substr(0, length));
+
+            return true;
+        }
+
+        bool Checkpoint::due() const
+        {
+            return std::chrono::steady_clock::now() - m_last_save >= m_interval;
+        }
+
+        void Checkpoint::save(const checkpoint_kind p_kind, const std::string_view p_identity, const std::string_view p_payload)
+        {
+            std::string contents{checkpoint_magic};
+
+            contents += static_cast<char>(checkpoint_version);
+            contents += static_cast<char>(p_kind);
+            detail::put_bytes(contents, p_identity);
+            detail::put_u64(contents, p_payload.length());
+            contents += p_payload;
+            detail::put_u64(contents, fnv1a(contents));
+
+            const std::string   tmp_name{m_file_name + ".tmp"};
+            const int           fd{::open(tmp_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)};
+
+            if (fd < 0) {
+                throw std::runtime_error(std::string("Cannot create ") + tmp_name + std::string(": ") + std::strerror(errno));
+            }
+
+            int error{};
+
+            for (std::size_t pos{}; pos < contents.length() && !error;) {
+                const ssize_t written{::write(fd, contents.data() + pos, contents.length() - pos)};
+
+                if (written < 0 && errno == EINTR) {
+                    continue;
+                }
+
+                if (written <= 0) {
+                    error = written < 0 ? errno : EIO;
+                } else {
+                    pos += static_cast<std::size_t>(written);
+                }
+            }
+
+            /* The data must be on disk before the rename makes it the snapshot, and the descriptor is closed whatever happens */
+            if (!error && ::fsync(fd) != 0) {
+                error = errno;
+            }
+
+            if (::close(fd) != 0 && !error) {
+                error = errno;
+            }
+
+            if (error) {
+                ::unlink(tmp_name.c_str());
+                throw std::runtime_error(std::string("Cannot write ") + tmp_name + std::string(": ") + std::strerror(error));
+            }
+
+            if (std::rename(tmp_name.c_str(), m_file_name.c_str()) != 0) {
+                error = errno;
+                ::unlink(tmp_name.c_str());
+                throw std::runtime_error(std::string("Cannot save ") + m_file_name + std::string(": ") + std::strerror(error));
+            }
+
+            /* The rename itself is only durable once the directory holding the snapshot is on disk */
+            const std::filesystem::path     dir_name{std::filesystem::path{m_file_name}.parent_path()};
+            const std::string               dir{dir_name.empty() ? std::string{"."} : dir_name.string()};
+            const int                       dir_fd{::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC)};
+
+            if (dir_fd < 0 || ::fsync(dir_fd) != 0) {
+                error = errno;
+
+                if (dir_fd >= 0) {
+                    ::close(dir_fd);
+                }
+
+                throw std::runtime_error(std::string("Cannot sync ") + dir + std::string(" after saving ") + m_file_name
+                                         + std::string(": ") + std::strerror(error));
+            }
+
+            ::close(dir_fd);
+
+            m_last_save = std::chrono::steady_clock::now();
+        }
+
+        void Checkpoint::remove()
+        {
+            std::remove(m_file_name.c_str());
+        }
+
+        namespace detail
+        {
+            void put_u64(std::string& p_out, const uint64_t p_value)
+            {
+                for (unsigned shift{}; shift < 64; shift += 8) {
+                    p_out += static_cast<char>((p_value >> shift) & 0xFF);
+                }
+            }
+
+            void put_bytes(std::string& p_out, const std::string_view p_bytes)
+            {
+                put_u64(p_out, p_bytes.length());
+                p_out += p_bytes;
+            }
+
+            uint64_t get_u64(std::string_view& p_in)
+            {
+                if (p_in.length() < 8) {
+                    throw std::runtime_error("Checkpoint payload is truncated");
+                }
+
+                uint64_t ret{};
+
+                for (unsigned index{}; index < 8; index++) {
+                    ret |= static_cast<uint64_t>(static_cast<uint8_t>(p_in[index])) << (8 * index);
+                }
+
+                p_in.remove_prefix(8);
+
+                return ret;
+            }
+
+            std::string_view get_bytes(std::string_view& p_in)
+            {
+                const uint64_t length{get_u64(p_in)};
+
+                if (p_in.length() < length) {
+                    throw std::runtime_error("Checkpoint payload is truncated");
+                }
+
+                const std::string_view ret{p_in.substr(0, length)};
+
+                p_in.remove_prefix(length);
+
+                return ret;
+            }
+
+            std::string file_identity(const std::string& p_file_name)
+            {
+                struct stat file_stat{};
+
+                if (::stat(p_file_name.c_str(), &file_stat) != 0 || !S_ISREG(file_stat.st_mode)) {
+                    return "";
+                }
+
+                return p_file_name + ", " + std::to_string(file_stat.st_size) + " bytes, modified "
+                       + std::to_string(file_stat.st_mtim.tv_sec) + "." + std::to_string(file_stat.st_mtim.tv_nsec);
+            }
+        }
+    }
+}
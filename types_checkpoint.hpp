@@ -0,0 +1,91 @@
+/*
+ * @brief kim::sec::Checkpoint Header File
+ * @author Edward Kim
+ */
+#ifndef TYPES_CHECKPOINT
+#define TYPES_CHECKPOINT
+
+#include <chrono>
+#include <string>
+#include <string_view>
+
+#include <cstddef>
+#include <cstdint>
+
+/* Checkpoint Class Declaration */
+namespace kim
+{
+    namespace sec
+    {
+        /* What a checkpoint holds, so that one scan never resumes from another's snapshot */
+        enum class checkpoint_kind : uint8_t
+        {
+            byte_scan = 1,          /* XOR_byte_dec over a file: offset and best candidates */
+            rep_key_corpus = 2      /* XOR_rep_key_dec_corpus: reports of the files already cracked */
+        };
+
+        /*
+         * Snapshot file of a long-running scan, so that a killed process can resume where it stopped
+         * - Layout (little endian): "KSCP" | version: 1 byte | kind: 1 byte | identity length: 8 bytes | identity
+         *   | payload length: 8 bytes | payload | FNV-1a 64 of all before it: 8 bytes
+         * - The identity names the input (see detail::file_identity), so a snapshot is never resumed against a changed file
+         * - Saved to a temporary file, flushed to disk and renamed over the previous snapshot, so a crash mid-save leaves the old one intact
+         * - due() rate limits the periodic saves to one per interval
+         */
+        class Checkpoint
+        {
+        public:
+            /*** Constructors ***/
+
+            /* Constructor which takes in the file name and the time between periodic saves */
+            explicit Checkpoint(std::string, const std::chrono::duration<double> = std::chrono::seconds{60});
+
+
+            /*** Public Methods ***/
+
+            /* Returns the file name */
+            const std::string&  file_name() const;
+
+            /* Reads the payload of a snapshot of the given kind, taken of the input with the given identity
+             * - Returns false if there is no snapshot or it is of another kind
+             * - Throws std::runtime_error if the snapshot is truncated or corrupt, or was taken of another input
+             */
+            bool                load(const checkpoint_kind, const std::string_view, std::string&) const;
+
+            /* Returns true once the interval has passed since the last save (or construction) */
+            bool                due() const;
+
+            /* Saves a snapshot of the given kind, input identity and payload (throws std::runtime_error if it cannot be written) */
+            void                save(const checkpoint_kind, const std::string_view, const std::string_view);
+
+            /* Deletes the snapshot, e.g. once the scan has finished */
+            void                remove();
+
+
+        private:
+            /*** Private Member Variables ***/
+
+            std::string                             m_file_name;
+
+            std::chrono::duration<double>           m_interval;
+
+            std::chrono::steady_clock::time_point   m_last_save{std::chrono::steady_clock::now()};
+        };
+
+        namespace detail
+        {
+            /* Little endian fields of checkpoint payloads (the readers throw std::runtime_error past the end) */
+            void                put_u64(std::string&, const uint64_t);
+            void                put_bytes(std::string&, const std::string_view);
+            uint64_t            get_u64(std::string_view&);
+            std::string_view    get_bytes(std::string_view&);
+
+            /* Returns the path, size and modification time of a regular file, or an empty string if it is not one
+             * (pipes and terminals have no identity, so their snapshots cannot be checked against them)
+             */
+            std::string         file_identity(const std::string&);
+        }
+    }
+}
+
+#endif /* TYPES_CHECKPOINT */
@@ -0,0 +1,269 @@
+/*
+ * @brief kim::sec Formatting Routines Source File
+ * @author Edward Kim
+ */
+#include "types_format.hpp"
+
+#include <array>
+#include <algorithm>
+#include <string_view>
+
+#include <cstdint>
+#include <cstring>
+
+namespace kim
+{
+    namespace sec
+    {
+        /* Bytes rendered per write by the streaming routines (a multiple of 16 so hex dump lines stay whole) */
+        static constexpr std::size_t stream_chunk{1024};
+
+        /* The 8 bit characters of every byte */
+        static constexpr std::array<std::array<char, 8>, 256> bits_table{[] {
+            std::array<std::array<char, 8>, 256> ret{};
+
+            for (std::size_t byte{}; byte < 256; byte++) {
+                for (std::size_t bit{}; bit < 8; bit++) {
+                    ret[byte][bit] = (byte >> (7 - bit)) & 1 ? '1' : '0';
+                }
+            }
+
+            return ret;
+        }()};
+
+        /* Mnemonics of the ASCII control characters, with DEL last */
+        static constexpr std::string_view control_table[] = { "(NUL)", "(SOH)", "(STX)", "(ETX)", "(EOT)",
+                                                              "(ENQ)", "(ACK)", "(BEL)",  "(BS)",  "(HT)",
+                                                                 "\n",  "(VT)",  "(FF)",  "(CR)",  "(SO)",
+                                                               "(SI)", "(DLE)", "(DC1)", "(DC2)", "(DC3)",
+                                                              "(DC4)", "(NAK)", "(SYN)", "(ETB)", "(CAN)",
+                                                               "(EM)", "(SUB)", "(ESC)",  "(FS)",  "(GS)",
+                                                               "(RS)",  "(US)", "(DEL)" };
+
+        /* Escaped length of every ASCII character */
+        static constexpr std::array<uint8_t, 128> ascii_length_table{[] {
+            std::array<uint8_t, 128> ret{};
+
+            for (std::size_t chr{}; chr < 128; chr++) {
+                ret[chr] = chr < 32 ? static_cast<uint8_t>(control_table[chr].length())
+                         : chr == 127 ? static_cast<uint8_t>(control_table[32].length()) : 1;
+            }
+
+            return ret;
+        }()};
+
+        static constexpr char hex_digits[] = "0123456789abcdef";
+
+        /* Hex dump offsets are 8 digits, or 16 once the dump passes 4 GiB */
+        static std::size_t offset_width(const std::size_t p_size)
+        {
+            return p_size > 0xFFFFFFFFULL ? 16 : 8;
+        }
+
+        static char* put_offset(std::size_t p_offset, const std::size_t p_width, char* p_out)
+        {
+            for (std::size_t index{p_width}; index > 0; index--) {
+                p_out[index - 1] = hex_digits[p_offset & 0xF];
+                p_offset >>= 4;
+            }
+
+            return p_out + p_width;
+        }
+
+        /* Writes the hex dump lines of the bytes (without the final offset line), starting at an offset */
+        static char* put_hexdump_lines(const ByteView p_view, const std::size_t p_base, const std::size_t p_width, char* p_out)
+        {
+            for (std::size_t line{}; line < p_view.length(); line += 16) {
+                const std::size_t count{std::min<std::size_t>(16, p_view.length() - line)};
+
+                p_out = put_offset(p_base + line, p_width, p_out);
+                *p_out++ = ' ';
+
+                for (std::size_t index{}; index < 16; index++) {
+                    if (index % 8 == 0) {
+                        *p_out++ = ' ';
+                    }
+
+                    if (index < count) {
+                        const uint8_t byte{std::to_integer<uint8_t>(p_view[line + index])};
+
+                        p_out[0] = hex_digits[byte >> 4];
+                        p_out[1] = hex_digits[byte & 0xF];
+                    } else {
+                        p_out[0] = ' ';
+                        p_out[1] = ' ';
+                    }
+
+                    p_out[2] = ' ';
+                    p_out += 3;
+                }
+
+                *p_out++ = ' ';
+                *p_out++ = '|';
+
+                for (std::size_t index{}; index < count; index++) {
+                    const uint8_t byte{std::to_integer<uint8_t>(p_view[line + index])};
+
+                    *p_out++ = byte >= 0x20 && byte < 0x7F ? static_cast<char>(byte) : '.';
+                }
+
+                *p_out++ = '|';
+                *p_out++ = '\n';
+            }
+
+            return p_out;
+        }
+
+        std::size_t bits_length(const std::size_t p_size)
+        {
+            return p_size ? p_size * 9 - 1 : 0;
+        }
+
+        std::size_t format_bits(const ByteView p_view, char* p_out)
+        {
+            for (std::size_t index{}; index < p_view.length(); index++) {
+                std::memcpy(p_out + index * 9, bits_table[std::to_integer<uint8_t>(p_view[index])].data(), 8);
+
+                if (index + 1 < p_view.length()) {
+                    p_out[index * 9 + 8] = ' ';
+                }
+            }
+
+            return bits_length(p_view.length());
+        }
+
+        std::string format_bits(const ByteView p_view)
+        {
+            std::string ret(bits_length(p_view.length()), '\0');
+
+            format_bits(p_view, ret.data());
+
+            return ret;
+        }
+
+        std::ostream& write_bits(std::ostream& os, const ByteView p_view)
+        {
+            char buffer[stream_chunk * 9];
+
+            for (std::size_t index{}; index < p_view.length(); index += stream_chunk) {
+                const std::size_t count{std::min(stream_chunk, p_view.length() - index)};
+
+                /* Every chunk after the first continues the space-separated sequence */
+                buffer[0] = ' ';
+                os.write(index ? buffer : buffer + 1,
+                         static_cast<std::streamsize>(format_bits(p_view.subview(index, count), buffer + 1) + (index ? 1 : 0)));
+            }
+
+            return os;
+        }
+
+        std::size_t ascii_length(const ByteView p_view)
+        {
+            std::size_t ret{};
+
+            for (const std::byte& e : p_view) {
+                const uint8_t byte{std::to_integer<uint8_t>(e)};
+
+                if (byte > 127) {
+                    return std::string::npos;
+                }
+
+                ret += ascii_length_table[byte];
+            }
+
+            return ret;
+        }
+
+        std::size_t format_ascii(const ByteView p_view, char* p_out)
+        {
+            char* const begin{p_out};
+
+            for (const std::byte& e : p_view) {
+                const uint8_t byte{std::to_integer<uint8_t>(e)};
+
+                if (byte >= 32 && byte < 127) {
+                    *p_out++ = static_cast<char>(byte);
+                } else {
+                    const std::string_view mnemonic{control_table[byte == 127 ? 32 : byte]};
+
+                    p_out = std::copy(mnemonic.begin(), mnemonic.end(), p_out);
+                }
+            }
+
+            return static_cast<std::size_t>(p_out - begin);
+        }
+
+        std::string format_ascii(const ByteView p_view)
+        {
+            const std::size_t length{ascii_length(p_view)};
+
+            if (length == std::string::npos) {
+                return "";
+            }
+
+            std::string ret(length, '\0');
+
+            format_ascii(p_view, ret.data());
+
+            return ret;
+        }
+
+        std::size_t hexdump_length(const std::size_t p_size)
+        {
+            if (p_size == 0) {
+                return 0;
+            }
+
+            /* Each line is the offset, 55 characters of hex, borders and LF, then the ASCII column */
+            const std::size_t width{offset_width(p_size)};
+
+            return (p_size / 16) * (width + 71) + (p_size % 16 ? width + 55 + p_size % 16 : 0) + width + 1;
+        }
+
+        std::size_t format_hexdump(const ByteView p_view, char* p_out)
+        {
+            if (p_view.empty()) {
+                return 0;
+            }
+
+            const std::size_t   width{offset_width(p_view.length())};
+            char*               end{put_hexdump_lines(p_view, 0, width, p_out)};
+
+            end = put_offset(p_view.length(), width, end);
+            *end++ = '\n';
+
+            return static_cast<std::size_t>(end - p_out);
+        }
+
+        std::string format_hexdump(const ByteView p_view)
+        {
+            std::string ret(hexdump_length(p_view.length()), '\0');
+
+            format_hexdump(p_view, ret.data());
+
+            return ret;
+        }
+
+        std::ostream& write_hexdump(std::ostream& os, const ByteView p_view)
+        {
+            if (p_view.empty()) {
+                return os;
+            }
+
+            const std::size_t   width{offset_width(p_view.length())};
+            char                buffer[stream_chunk / 16 * (16 + 71)];
+
+            for (std::size_t index{}; index < p_view.length(); index += stream_chunk) {
+                const char* const end{put_hexdump_lines(p_view.subview(index, stream_chunk), index, width, buffer)};
+
+                os.write(buffer, end - buffer);
+            }
+
+            char* const end{put_offset(p_view.length(), width, buffer)};
+
+            *end = '\n';
+
+            return os.write(buffer, end + 1 - buffer);
+        }
+    }
+}
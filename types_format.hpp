@@ -0,0 +1,67 @@
+/*
+ * @brief kim::sec Formatting Routines Header File
+ * @author Edward Kim
+ *
+ * Each rendering has three forms: one that writes into a caller-provided buffer of the size
+ * returned by its *_length function, one that returns a string allocated once at that size, and
+ * one that streams through a fixed stack buffer so dumping a large buffer never allocates.
+ */
+#ifndef TYPES_FORMAT
+#define TYPES_FORMAT
+
+#include <iostream>
+#include <string>
+
+#include <cstddef>
+
+#include "types_view.hpp"
+
+/* Formatting Routine Declarations */
+namespace kim
+{
+    namespace sec
+    {
+        /*** Bit Strings: 8 bits per byte, most significant first, separated by spaces ***/
+
+        /* Returns the number of characters in the bit string of the given number of bytes */
+        std::size_t     bits_length(const std::size_t);
+
+        /* Writes the bit string of the bytes, returning the number of characters written */
+        std::size_t     format_bits(const ByteView, char*);
+
+        /* Returns the bit string of the bytes */
+        std::string     format_bits(const ByteView);
+
+        /* Writes the bit string of the bytes to a stream */
+        std::ostream&   write_bits(std::ostream&, const ByteView);
+
+
+        /*** ASCII: printable characters and LF as is, other control characters as mnemonics, e.g. (NUL) ***/
+
+        /* Returns the number of characters in the escaped ASCII string, or std::string::npos if a byte is not ASCII */
+        std::size_t     ascii_length(const ByteView);
+
+        /* Writes the escaped ASCII string of the bytes (which must all be ASCII), returning the number of characters written */
+        std::size_t     format_ascii(const ByteView, char*);
+
+        /* Returns the escaped ASCII string of the bytes, or an empty string if a byte is not ASCII */
+        std::string     format_ascii(const ByteView);
+
+
+        /*** Hex Dumps: the layout of hexdump -C -v, 16 bytes per line with offsets and an ASCII column ***/
+
+        /* Returns the number of characters in the hex dump of the given number of bytes */
+        std::size_t     hexdump_length(const std::size_t);
+
+        /* Writes the hex dump of the bytes, returning the number of characters written */
+        std::size_t     format_hexdump(const ByteView, char*);
+
+        /* Returns the hex dump of the bytes */
+        std::string     format_hexdump(const ByteView);
+
+        /* Writes the hex dump of the bytes to a stream */
+        std::ostream&   write_hexdump(std::ostream&, const ByteView);
+    }
+}
+
+#endif /* TYPES_FORMAT */
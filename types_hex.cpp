@@ -5,6 +5,8 @@
 #include "types_hex.hpp"
 
 #include <stdexcept>
+#include <utility>
+#include <algorithm>
 
 #include <cctype>
 #include <cstdint>
@@ -12,6 +14,8 @@
 
 #include "types_bin.hpp"
 #include "types_b64.hpp"
+#include "types_validate.hpp"
+#include "types_stats.hpp"
 
 namespace kim
 {
@@ -19,42 +23,44 @@ namespace kim
     {
         Hex::Hex() { }
 
-        Hex::Hex(const std::string& p_str)
-        {
-            if (p_str.empty()) {
-                return;
-            }
+        Hex::Hex(std::pmr::memory_resource* p_resource) : m_hex{p_resource} { }
 
-            /* String must have an even number of characters */
-            if (p_str.length() % 2 != 0) {
-                throw std::invalid_argument(std::string("The length of the string ")
-                                            + p_str + std::string(" is not even"));
+        /* Throws the exception for an invalid character, only reached on failure */
+        static void throw_invalid_hex(const char p_chr, const std::size_t p_offset)
+        {
+            if (!isalnum(static_cast<unsigned char>(p_chr))) {
+                throw std::invalid_argument(std::string("Hexadecimal string contains a non-alphanumeric at offset ")
+                                            + std::to_string(p_offset));
             }
 
-            m_hex.reserve(p_str.length());
-
-            /* Check if the string is a valid Hexadecimal string */
-            for (const char& e : p_str) {
-                if (!isalnum(e)) {
-                    throw std::invalid_argument(p_str + std::string(" contains a non-alphanumeric"));
-                } else if (isalpha(e) && (toupper(e) > 'F' || toupper(e) < 'A')) {
-                    throw std::invalid_argument(p_str + std::string(" contains a letter that is not from A-F"));
-                } else {
-                    m_hex.push_back(toupper(e));
-                }
-            }
+            throw std::invalid_argument(std::string("Hexadecimal string contains a letter that is not from A-F at offset ")
+                                        + std::to_string(p_offset));
         }
 
-        Hex::Hex(const Binary& p_Bin)
+        /* Throws the exception for an odd number of characters */
+        static void check_hex_length(const std::size_t p_len)
         {
-            *this = p_Bin.to_Hex();
+            if (p_len % 2 != 0) {
+                throw std::invalid_argument(std::string("The length of the Hexadecimal string (")
+                                            + std::to_string(p_len) + std::string(") is not even"));
+            }
         }
 
-        Hex::Hex(const Hex& p_Hex)
+        Hex::Hex(const std::string& p_str) : Hex{std::string_view{p_str}, std::pmr::get_default_resource()} { }
+
+        Hex::Hex(std::string_view p_str, std::pmr::memory_resource* p_resource) : m_hex{p_resource}
         {
-            this->m_hex = p_Hex.m_hex;
+            KIM_SEC_PROBE(probe::Hex_parse, p_str.length());
+
+            append(p_str);
         }
 
+        Hex::Hex(const Binary& p_Bin) : Hex{p_Bin.to_Hex()} { }
+
+        Hex::Hex(const Hex& p_Hex) : m_hex{p_Hex.m_hex} { }
+
+        Hex::Hex(Hex&& p_Hex) noexcept : m_hex{std::move(p_Hex.m_hex)} { }
+
         Hex::~Hex() { }
 
         std::size_t Hex::length() const
@@ -72,27 +78,24 @@ namespace kim
             m_hex.reserve(p_size);
         }
 
-        Hex& Hex::append(const std::string& p_str)
+        Hex& Hex::append(std::string_view p_str)
         {
             if (p_str.empty()) {
                 return *this;
             }
 
             /* String must have an even number of characters */
-            if (p_str.length() % 2 != 0) {
-                throw std::invalid_argument(std::string("The length of the string ")
-                                            + p_str + std::string(" is not even"));
-            }
+            check_hex_length(p_str.length());
+
+            const std::size_t   old_length{m_hex.length()};
+            m_hex.resize(old_length + p_str.length());
+
+            /* Check if the string is a valid Hexadecimal string while copying it in uppercase */
+            const std::size_t   bad_offset{detail::hex_copy_upper(p_str.data(), p_str.length(), m_hex.data() + old_length)};
 
-            /* Check if the string is a valid Hexadecimal string */
-            for (const char& e : p_str) {
-                if (!isalnum(e)) {
-                    throw std::invalid_argument(p_str + std::string(" contains a non-alphanumeric"));
-                } else if (isalpha(e) && (toupper(e) > 'F' || toupper(e) < 'A')) {
-                    throw std::invalid_argument(p_str + std::string(" contains a letter that is not from A-F"));
-                } else {
-                    m_hex.push_back(toupper(e));
-                }
+            if (bad_offset != p_str.length()) {
+                m_hex.resize(old_length);
+                throw_invalid_hex(p_str[bad_offset], bad_offset);
             }
 
             return *this;
@@ -104,19 +107,42 @@ namespace kim
                 throw std::invalid_argument("Truncation size is not a multiple of 2");
             }
 
-            m_hex = m_hex.substr(0, m_hex.length() - p_size);
+            m_hex.erase(m_hex.length() - std::min(p_size, m_hex.length()));
 
             return *this;
         }
 
+        Hex Hex::from_valid(std::pmr::string&& p_str)
+        {
+            Hex ret{p_str.get_allocator().resource()};
+            ret.m_hex = std::move(p_str);
+
+            return ret;
+        }
+
         Binary Hex::to_Bin() const
         {
-            Binary ret{};
+            return to_Bin(resource());
+        }
+
+        Binary Hex::to_Bin(std::pmr::memory_resource* p_resource) const
+        {
+            KIM_SEC_PROBE(probe::Hex_to_Bin, m_hex.length());
 
-            ret.reserve(m_hex.length());
+            Binary ret{p_resource};
+
+            /* The stored string is validated uppercase Hexadecimal */
+            auto nibble{
+                            [](const char p_chr)
+                            {
+                                return static_cast<uint8_t>(p_chr <= '9' ? p_chr - '0' : p_chr - 'A' + 10);
+                            }
+                        };
+
+            ret.reserve(m_hex.length() / 2);
 
             for (std::size_t i{}; i < m_hex.length(); i += 2) {
-                ret.push_back(static_cast<std::byte>(std::stoi(m_hex.substr(i, 2), nullptr, 16)));
+                ret.push_back(static_cast<std::byte>((nibble(m_hex[i]) << 4) | nibble(m_hex[i + 1])));
             }
 
             return ret;
@@ -124,67 +150,57 @@ namespace kim
 
         Base64 Hex::to_B64() const
         {
-            Base64              ret{};
-            const Binary        this_Bin{this->to_Bin()};
-            std::size_t         index{};
-            const char          base64_table[] = { 'A', 'B', 'C', 'D', 'E', 'F', 'G',
-                                                   'H', 'I', 'J', 'K', 'L', 'M', 'N',
-                                                   'O', 'P', 'Q', 'R', 'S', 'T', 'U',
-                                                   'V', 'W', 'X', 'Y', 'Z', 'a', 'b',
-                                                   'c', 'd', 'e', 'f', 'g', 'h', 'i',
-                                                   'j', 'k', 'l', 'm', 'n', 'o', 'p',
-                                                   'q', 'r', 's', 't', 'u', 'v', 'w',
-                                                   'x', 'y', 'z', '0', '1', '2', '3',
-                                                   '4', '5', '6', '7', '8', '9', '+', '/' };
-
-            ret.reserve(m_hex.length() * 2 / 3 + (m_hex.length() * 2 % 3));
-
-            /* Loop through every 3 bytes of the binary representation of the hexadecimal
-               string but only until the set that does not need padding */
-            for (; index < (this_Bin.length() / 3) * 3; index += 3) {
-                std::string append_str{};
-
-                append_str.push_back(base64_table[std::to_integer<uint8_t>(this_Bin[index] >> 2)]);
-                append_str.push_back(base64_table[std::to_integer<uint8_t>((this_Bin[index] & std::byte{0b00000011}) << 4)
-                                             + std::to_integer<uint8_t>(this_Bin[index + 1] >> 4)]);
-                append_str.push_back(base64_table[std::to_integer<uint8_t>((this_Bin[index + 1] & std::byte{0b00001111}) << 2)
-                                             + std::to_integer<uint8_t>(this_Bin[index + 2] >> 6)]);
-                append_str.push_back(base64_table[std::to_integer<uint8_t>(this_Bin[index + 2] & std::byte{0b00111111})]);
-
-                ret.append(append_str);
-            }
+            KIM_SEC_PROBE(probe::Hex_to_B64, m_hex.length());
 
-            /* If there are any remaining bytes, compute those and add padding */
-            const std::size_t       remaining{this_Bin.length() % 3};
-            std::string             append_str{};
-
-            if (remaining == 1) {
-                append_str.push_back(base64_table[std::to_integer<uint8_t>(this_Bin[index] >> 2)]);
-                append_str.push_back(base64_table[std::to_integer<uint8_t>((this_Bin[index] & std::byte{0b00000011}) << 4)]);
-                append_str.append("==");
-            } else if (remaining == 2) {
-                append_str.push_back(base64_table[std::to_integer<uint8_t>(this_Bin[index] >> 2)]);
-                append_str.push_back(base64_table[std::to_integer<uint8_t>((this_Bin[index] & std::byte{0b00000011}) << 4)
-                                             + std::to_integer<uint8_t>(this_Bin[index + 1] >> 4)]);
-                append_str.push_back(base64_table[std::to_integer<uint8_t>((this_Bin[index + 1] & std::byte{0b00001111}) << 2)]);
-                append_str.push_back('=');
-            }
+            Base64          ret{resource()};
+            const Binary    this_Bin{this->to_Bin()};
 
-            ret.append(append_str);
+            ret.append(this_Bin.view());
 
             return ret;
         }
 
+        Hex& Hex::operator=(const Hex& rhs)
+        {
+            m_hex = rhs.m_hex;
+
+            return *this;
+        }
+
+        Hex& Hex::operator=(Hex&& rhs)
+        {
+            m_hex = std::move(rhs.m_hex);
+
+            return *this;
+        }
+
+        std::pmr::memory_resource* Hex::resource() const
+        {
+            return m_hex.get_allocator().resource();
+        }
+
         Hex& Hex::operator+=(const Hex& rhs)
         {
-            return this->append(rhs.m_hex);
+            m_hex += rhs.m_hex;
+
+            return *this;
+        }
+
+        Hex Hex::operator+(const Hex& rhs) const &
+        {
+            std::pmr::string ret_str{resource()};
+            ret_str.reserve(m_hex.length() + rhs.m_hex.length());
+            ret_str.append(m_hex).append(rhs.m_hex);
+
+            return from_valid(std::move(ret_str));
         }
 
-        Hex Hex::operator+(const Hex& rhs)
+        Hex Hex::operator+(const Hex& rhs) &&
         {
-            Hex this_copy{*this};
+            /* Both operands are already valid, so concatenation needs no validation */
+            m_hex += rhs.m_hex;
 
-            return this_copy.append(rhs.m_hex);
+            return std::move(*this);
         }
 
         std::ostream& operator<<(std::ostream& os, const Hex& p_Hex)
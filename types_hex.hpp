@@ -7,6 +7,9 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <memory_resource>
+#include <type_traits>
 
 /* Forward Declarations */
 namespace kim
@@ -31,15 +34,30 @@ namespace kim
             /* Empty Constructor */
             Hex();
 
-            /* Constructor which takes in a string */
+            /* Empty Constructor which allocates from the given memory resource */
+            explicit Hex(std::pmr::memory_resource*);
+
+            /* Constructor which takes in a string (validated and uppercased in a single pass) */
             Hex(const std::string&);
 
+            /* Constructor which takes in a std::string_view without an intermediate std::string
+             * - Constrained to exactly std::string_view so string literals still pick the std::string overload
+             */
+            template <class StringView, std::enable_if_t<std::is_same_v<StringView, std::string_view>, int> = 0>
+            Hex(const StringView& p_str) : Hex{p_str, std::pmr::get_default_resource()} { }
+
+            /* Constructor which takes in a string and allocates from the given memory resource */
+            Hex(std::string_view, std::pmr::memory_resource*);
+
             /* Constructor which takes in a Binary object */
             Hex(const Binary&);
 
-            /* Copy Constructor */
+            /* Copy Constructor (the copy uses the default memory resource) */
             Hex(const Hex&);
 
+            /* Move Constructor */
+            Hex(Hex&&) noexcept;
+
             /* Destructor */
             ~Hex();
 
@@ -55,8 +73,8 @@ namespace kim
             /* Reserves space for the Hexadecimal string specified by a size_t argument */
             void                reserve(const std::string::size_type);
 
-            /* Appends a string with valid Hexadecimal */
-            Hex&                append(const std::string&);
+            /* Appends a string with valid Hexadecimal (the Hexadecimal object is unchanged if it throws) */
+            Hex&                append(std::string_view);
 
             /* Removes the specified number of Hexadecimal digits from the back (must be even) */
             Hex&                discard(const std::string::size_type = 2);
@@ -64,28 +82,53 @@ namespace kim
             /* Returns the Binary object equivalent of the Hexadecimal string */
             Binary              to_Bin() const;
 
+            /* Returns the Binary object equivalent of the Hexadecimal string, allocated from the given memory resource */
+            Binary              to_Bin(std::pmr::memory_resource*) const;
+
+            /* Returns the memory resource used by the Hexadecimal string */
+            std::pmr::memory_resource*  resource() const;
+
             /* Returns the Base64 object equivalent of the Hexadecimal string */
             Base64              to_B64() const;
 
 
             /*** Operators ***/
 
+            /* Copy Assignment Operator */
+            Hex&                operator=(const Hex&);
+
+            /* Move Assignment Operator (copies if the memory resources differ) */
+            Hex&                operator=(Hex&&);
+
             /* Appends another Hexadecimal object */
             Hex&                operator+=(const Hex&);
 
             /* Returns the concatenation of two Hexadecimal objects */
-            Hex                 operator+(const Hex&);
+            Hex                 operator+(const Hex&) const &;
+
+            /* Returns the concatenation of two Hexadecimal objects, reusing the buffer of an rvalue lhs */
+            Hex                 operator+(const Hex&) &&;
 
 
         private:
+            /*** Private Methods ***/
+
+            /* Takes ownership of a string which is already valid uppercase Hexadecimal (skips validation) */
+            static Hex          from_valid(std::pmr::string&&);
+
+
             /*** Private Member Variables ***/
 
             /* Underlying Data Structure */
-            std::string m_hex;
+            std::pmr::string m_hex;
 
 
         /*** Friends ***/
 
+        /* Trusted construction from conversions */
+        friend class Binary;
+        friend class Base64;
+
         /* std::cout */
         friend std::ostream& operator<<(std::ostream&, const Hex&);
         };
@@ -0,0 +1,109 @@
+/*
+ * @brief kim::sec::MappedFile Source File
+ * @author Edward Kim
+ */
+#include "types_mmap.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace kim
+{
+    namespace sec
+    {
+        /* Bytes from the start of a mapping that are read ahead at once */
+        static constexpr std::size_t prefetch_window{std::size_t{8} << 20};
+
+        MappedFile::MappedFile(const std::string& p_file_name)
+        {
+            const int fd{::open(p_file_name.c_str(), O_RDONLY | O_CLOEXEC)};
+
+            if (fd < 0) {
+                throw std::runtime_error(std::string("Cannot open ") + p_file_name + std::string(": ") + std::strerror(errno));
+            }
+
+            struct stat file_stat{};
+
+            if (::fstat(fd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode)) {
+                ::close(fd);
+                throw std::runtime_error(p_file_name + std::string(" is not a regular file"));
+            }
+
+            m_len = static_cast<std::size_t>(file_stat.st_size);
+
+            if (m_len) {
+                void* const addr{::mmap(nullptr, m_len, PROT_READ, MAP_PRIVATE, fd, 0)};
+
+                if (addr == MAP_FAILED) {
+                    const int err{errno};
+                    ::close(fd);
+                    throw std::runtime_error(std::string("Cannot map ") + p_file_name + std::string(": ") + std::strerror(err));
+                }
+
+                /* Advice values are not flags, so each needs its own call
+                 * - Sequential over the whole mapping: aggressive read-ahead, pages dropped soon after use
+                 * - Will-need only for the leading window, so that a multi-GB file is not prefetched whole
+                 * Both are only hints, which a kernel may not support, so a failure leaves the mapping as it is
+                 */
+                static_cast<void>(::madvise(addr, m_len, MADV_SEQUENTIAL));
+                static_cast<void>(::madvise(addr, std::min(m_len, prefetch_window), MADV_WILLNEED));
+
+                m_data = static_cast<const std::byte*>(addr);
+            }
+
+            /* The mapping stays valid after the descriptor is closed */
+            ::close(fd);
+        }
+
+        MappedFile::MappedFile(MappedFile&& p_File) noexcept : m_data{p_File.m_data}, m_len{p_File.m_len}
+        {
+            p_File.m_data = nullptr;
+            p_File.m_len = 0;
+        }
+
+        MappedFile& MappedFile::operator=(MappedFile&& p_File) noexcept
+        {
+            if (this != &p_File) {
+                if (m_data) {
+                    ::munmap(const_cast<std::byte*>(m_data), m_len);
+                }
+
+                m_data = p_File.m_data;
+                m_len = p_File.m_len;
+                p_File.m_data = nullptr;
+                p_File.m_len = 0;
+            }
+
+            return *this;
+        }
+
+        MappedFile::~MappedFile()
+        {
+            if (m_data) {
+                ::munmap(const_cast<std::byte*>(m_data), m_len);
+            }
+        }
+
+        std::size_t MappedFile::length() const
+        {
+            return m_len;
+        }
+
+        ByteView MappedFile::view() const
+        {
+            return ByteView{m_data, m_len};
+        }
+
+        std::string_view MappedFile::str() const
+        {
+            return std::string_view{reinterpret_cast<const char*>(m_data), m_len};
+        }
+    }
+}
@@ -0,0 +1,71 @@
+/*
+ * @brief kim::sec::MappedFile Header File
+ * @author Edward Kim
+ */
+#ifndef TYPES_MMAP
+#define TYPES_MMAP
+
+#include <string>
+#include <string_view>
+
+#include <cstddef>
+
+#include "types_view.hpp"
+
+/* MappedFile Class Declaration */
+namespace kim
+{
+    namespace sec
+    {
+        /*
+         * Read-only memory mapping of a whole regular file
+         * - Pages are faulted in on demand, with a sequential read-ahead hint and the first 8 MiB requested up front
+         * - Views handed out are only valid while the MappedFile is alive
+         */
+        class MappedFile
+        {
+        public:
+            /*** Constructors/Destructor ***/
+
+            /* Constructor which takes in the file name (throws std::runtime_error if it cannot be mapped) */
+            explicit MappedFile(const std::string&);
+
+            /* Mappings are unique, so they can be moved but not copied */
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            /* Move Constructor */
+            MappedFile(MappedFile&&) noexcept;
+
+            /* Move Assignment Operator */
+            MappedFile& operator=(MappedFile&&) noexcept;
+
+            /* Destructor */
+            ~MappedFile();
+
+
+            /*** Public Methods ***/
+
+            /* Returns the size of the file in bytes */
+            std::size_t         length() const;
+
+            /* Returns a view of the file contents as bytes */
+            ByteView            view() const;
+
+            /* Returns a view of the file contents as characters */
+            std::string_view    str() const;
+
+
+        private:
+            /*** Private Member Variables ***/
+
+            /* Start of the mapping (nullptr for an empty file) */
+            const std::byte* m_data{};
+
+            /* Length of the mapping */
+            std::size_t m_len{};
+        };
+    }
+}
+
+#endif /* TYPES_MMAP */
@@ -0,0 +1,77 @@
+/*
+ * @brief kim::sec::ThreadPool Source File
+ * @author Edward Kim
+ */
+#include "types_pool.hpp"
+
+#include <algorithm>
+
+namespace kim
+{
+    namespace sec
+    {
+        ThreadPool::ThreadPool(std::size_t p_threads)
+        {
+            if (p_threads == 0) {
+                p_threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+            }
+
+            m_workers.reserve(p_threads);
+
+            for (std::size_t index{}; index < p_threads; index++) {
+                m_workers.emplace_back(&ThreadPool::work, this);
+            }
+        }
+
+        ThreadPool::~ThreadPool()
+        {
+            {
+                const std::lock_guard<std::mutex> lock{m_mutex};
+                m_stop = true;
+            }
+
+            m_ready.notify_all();
+
+            for (std::thread& e : m_workers) {
+                e.join();
+            }
+        }
+
+        std::size_t ThreadPool::size() const
+        {
+            return m_workers.size();
+        }
+
+        void ThreadPool::push(std::function<void()>&& p_task)
+        {
+            {
+                const std::lock_guard<std::mutex> lock{m_mutex};
+                m_tasks.push(std::move(p_task));
+            }
+
+            m_ready.notify_one();
+        }
+
+        void ThreadPool::work()
+        {
+            for (;;) {
+                std::function<void()> task{};
+
+                {
+                    std::unique_lock<std::mutex> lock{m_mutex};
+                    m_ready.wait(lock, [this] { return m_stop || !m_tasks.empty(); });
+
+                    if (m_tasks.empty()) {
+                        return;
+                    }
+
+                    task = std::move(m_tasks.front());
+                    m_tasks.pop();
+                }
+
+                /* packaged_task stores any exception in the future */
+                task();
+            }
+        }
+    }
+}
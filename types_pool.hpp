@@ -0,0 +1,88 @@
+/*
+ * @brief kim::sec::ThreadPool Header File
+ * @author Edward Kim
+ */
+#ifndef TYPES_POOL
+#define TYPES_POOL
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+
+#include <cstddef>
+
+/* ThreadPool Class Declaration */
+namespace kim
+{
+    namespace sec
+    {
+        /*
+         * Fixed set of worker threads running submitted tasks in FIFO order
+         * - Results and exceptions are handed back through std::future
+         * - The destructor finishes every queued task before joining the workers
+         */
+        class ThreadPool
+        {
+        public:
+            /*** Constructors/Destructor ***/
+
+            /* Constructor which takes in the number of threads, 0 for one per hardware thread */
+            explicit ThreadPool(const std::size_t = 0);
+
+            /* Workers refer to the pool, so it can be neither copied nor moved */
+            ThreadPool(const ThreadPool&) = delete;
+            ThreadPool& operator=(const ThreadPool&) = delete;
+
+            /* Destructor */
+            ~ThreadPool();
+
+
+            /*** Public Methods ***/
+
+            /* Returns the number of worker threads */
+            std::size_t         size() const;
+
+            /* Queues a task and returns the future of its result */
+            template <class Task>
+            std::future<std::invoke_result_t<std::decay_t<Task>>> submit(Task&& p_task)
+            {
+                using result = std::invoke_result_t<std::decay_t<Task>>;
+
+                /* std::function needs a copyable target, so the move-only packaged_task is shared */
+                const auto          task{std::make_shared<std::packaged_task<result()>>(std::forward<Task>(p_task))};
+                std::future<result> ret{task->get_future()};
+
+                push([task] { (*task)(); });
+
+                return ret;
+            }
+
+
+        private:
+            /*** Private Methods ***/
+
+            /* Queues a type-erased task and wakes a worker */
+            void                push(std::function<void()>&&);
+
+            /* Worker thread loop */
+            void                work();
+
+
+            /*** Private Member Variables ***/
+
+            std::vector<std::thread>            m_workers{};
+            std::queue<std::function<void()>>   m_tasks{};
+            std::mutex                          m_mutex{};
+            std::condition_variable             m_ready{};
+            bool                                m_stop{};
+        };
+    }
+}
+
+#endif /* TYPES_POOL */
@@ -0,0 +1,241 @@
+/*
+ * @brief kim::sec Output Sinks Source File
+ * @author Edward Kim
+ */
+#include "types_sink.hpp"
+
+#include <stdexcept>
+#include <algorithm>
+#include <utility>
+#include <cstring>
+#include <cerrno>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace kim
+{
+    namespace sec
+    {
+        /*** Sink ***/
+
+        Sink::~Sink() { }
+
+        void Sink::write(const std::string_view p_str)
+        {
+            write(ByteView{reinterpret_cast<const std::byte*>(p_str.data()), p_str.length()});
+        }
+
+        void Sink::flush() { }
+
+
+        /*** FileSink ***/
+
+        FileSink::FileSink(const std::string& p_file_name, const std::size_t p_buffer_size)
+            : m_capacity{std::max<std::size_t>(p_buffer_size, 1)}
+        {
+            m_fd = ::open(p_file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+            if (m_fd < 0) {
+                throw std::runtime_error(std::string("Cannot create ") + p_file_name + std::string(": ") + std::strerror(errno));
+            }
+
+            /* The destructor does not run if a constructor throws, so the file is closed by hand */
+            try {
+                m_front.reserve(m_capacity);
+                m_back.reserve(m_capacity);
+                m_writer = std::thread{&FileSink::work, this};
+            } catch (...) {
+                ::close(m_fd);
+                throw;
+            }
+        }
+
+        FileSink::~FileSink()
+        {
+            try {
+                close();
+            } catch (...) {
+                /* Destructors cannot report the error, close() explicitly to see it */
+            }
+        }
+
+        void FileSink::close()
+        {
+            if (m_fd < 0) {
+                return;
+            }
+
+            std::exception_ptr error{};
+
+            try {
+                flush();
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            {
+                const std::lock_guard<std::mutex> lock{m_mutex};
+                m_stop = true;
+            }
+
+            m_ready.notify_all();
+            m_writer.join();
+
+            /* A failed close can lose data written back late (NFS, full disks) */
+            if (::close(std::exchange(m_fd, -1)) != 0 && !error) {
+                error = std::make_exception_ptr(std::runtime_error(std::string("Cannot close output: ") + std::strerror(errno)));
+            }
+
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        void FileSink::write(const ByteView p_bytes)
+        {
+            if (m_fd < 0) {
+                throw std::runtime_error("Cannot write output: the file is closed");
+            }
+
+            check();
+
+            const char* data{reinterpret_cast<const char*>(p_bytes.data())};
+
+            for (std::size_t left{p_bytes.length()}; left;) {
+                const std::size_t chunk{std::min(left, m_capacity - m_front.length())};
+
+                m_front.append(data, chunk);
+                data += chunk;
+                left -= chunk;
+
+                if (m_front.length() == m_capacity) {
+                    submit();
+                }
+            }
+        }
+
+        void FileSink::flush()
+        {
+            if (!m_front.empty()) {
+                submit();
+            }
+
+            {
+                std::unique_lock<std::mutex> lock{m_mutex};
+                m_ready.wait(lock, [this] { return !m_pending; });
+            }
+
+            check();
+        }
+
+        void FileSink::submit()
+        {
+            {
+                std::unique_lock<std::mutex> lock{m_mutex};
+                m_ready.wait(lock, [this] { return !m_pending; });
+
+                m_front.swap(m_back);
+                m_pending = true;
+            }
+
+            m_ready.notify_all();
+            m_front.clear();
+        }
+
+        void FileSink::check()
+        {
+            const std::lock_guard<std::mutex> lock{m_mutex};
+
+            if (m_error) {
+                std::rethrow_exception(std::exchange(m_error, nullptr));
+            }
+        }
+
+        void FileSink::work()
+        {
+            std::unique_lock<std::mutex> lock{m_mutex};
+
+            for (;;) {
+                m_ready.wait(lock, [this] { return m_pending || m_stop; });
+
+                if (!m_pending) {
+                    return;
+                }
+
+                /* The back buffer is only touched by this thread while pending, so the lock can be dropped */
+                lock.unlock();
+
+                std::exception_ptr error{};
+
+                for (std::size_t done{}; done < m_back.length();) {
+                    const ssize_t written{::write(m_fd, m_back.data() + done, m_back.length() - done)};
+
+                    if (written < 0) {
+                        if (errno == EINTR) {
+                            continue;
+                        }
+
+                        error = std::make_exception_ptr(std::runtime_error(std::string("Cannot write output: ") + std::strerror(errno)));
+                        break;
+                    }
+
+                    done += static_cast<std::size_t>(written);
+                }
+
+                m_back.clear();
+                lock.lock();
+
+                if (error && !m_error) {
+                    m_error = error;
+                }
+
+                m_pending = false;
+                m_ready.notify_all();
+            }
+        }
+
+
+        /*** MemorySink ***/
+
+        void MemorySink::write(const ByteView p_bytes)
+        {
+            m_data.append(reinterpret_cast<const char*>(p_bytes.data()), p_bytes.length());
+        }
+
+        std::string_view MemorySink::str() const
+        {
+            return m_data;
+        }
+
+        void MemorySink::clear()
+        {
+            m_data.clear();
+        }
+
+
+        /*** CallbackSink ***/
+
+        CallbackSink::CallbackSink(std::function<void(ByteView)> p_callback) : m_callback{std::move(p_callback)} { }
+
+        void CallbackSink::write(const ByteView p_bytes)
+        {
+            m_callback(p_bytes);
+        }
+
+
+        /*** StreamSink ***/
+
+        StreamSink::StreamSink(std::ostream& p_stream) : m_stream{p_stream} { }
+
+        void StreamSink::write(const ByteView p_bytes)
+        {
+            m_stream.write(reinterpret_cast<const char*>(p_bytes.data()), static_cast<std::streamsize>(p_bytes.length()));
+        }
+
+        void StreamSink::flush()
+        {
+            m_stream.flush();
+        }
+    }
+}
@@ -0,0 +1,184 @@
+/*
+ * @brief kim::sec Output Sinks Header File
+ * @author Edward Kim
+ */
+#ifndef TYPES_SINK
+#define TYPES_SINK
+
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+#include <cstddef>
+
+#include "types_view.hpp"
+
+/* Sink Class Declarations */
+namespace kim
+{
+    namespace sec
+    {
+        /*
+         * Destination for the output of the file-based attacks
+         * - Writes may be buffered until flush() or destruction
+         */
+        class Sink
+        {
+        public:
+            /*** Constructors/Destructor ***/
+
+            Sink() = default;
+            Sink(const Sink&) = delete;
+            Sink& operator=(const Sink&) = delete;
+
+            /* Destructor */
+            virtual ~Sink();
+
+
+            /*** Public Methods ***/
+
+            /* Writes bytes */
+            virtual void        write(const ByteView) = 0;
+
+            /* Writes characters */
+            void                write(const std::string_view);
+
+            /* Waits until everything written so far has reached the destination */
+            virtual void        flush();
+        };
+
+        /*
+         * Sink writing to a file from a background thread
+         * - Double-buffered: the caller fills one buffer while the writer thread drains the other
+         * - Write errors are rethrown as std::runtime_error by the next write(), flush() or close()
+         */
+        class FileSink : public Sink
+        {
+        public:
+            /*** Constructors/Destructor ***/
+
+            /* Constructor which takes in the file name and the size of each buffer in bytes (throws std::runtime_error if it cannot be created) */
+            explicit FileSink(const std::string&, const std::size_t = 1 << 20);
+
+            /* Destructor, closes the file if close() was not called (errors are lost, close() explicitly to see them) */
+            ~FileSink() override;
+
+
+            /*** Public Methods ***/
+
+            using Sink::write;
+
+            void                write(const ByteView) override;
+
+            void                flush() override;
+
+            /* Flushes, stops the writer thread and closes the file (throws std::runtime_error on failure), later writes throw */
+            void                close();
+
+
+        private:
+            /*** Private Methods ***/
+
+            /* Hands the front buffer to the writer thread, waiting for it to finish the previous one */
+            void                submit();
+
+            /* Rethrows a write error of the writer thread */
+            void                check();
+
+            /* Writer thread loop */
+            void                work();
+
+
+            /*** Private Member Variables ***/
+
+            int                     m_fd{-1};
+            std::size_t             m_capacity;
+            std::string             m_front{};
+            std::string             m_back{};
+            bool                    m_pending{};
+            bool                    m_stop{};
+            std::exception_ptr      m_error{};
+            std::mutex              m_mutex{};
+            std::condition_variable m_ready{};
+            std::thread             m_writer{};
+        };
+
+        /* Sink collecting the output in memory */
+        class MemorySink : public Sink
+        {
+        public:
+            /*** Public Methods ***/
+
+            using Sink::write;
+
+            void                write(const ByteView) override;
+
+            /* Returns everything written so far */
+            std::string_view    str() const;
+
+            /* Discards everything written so far */
+            void                clear();
+
+
+        private:
+            /*** Private Member Variables ***/
+
+            std::string m_data{};
+        };
+
+        /* Sink handing every write to a user callback */
+        class CallbackSink : public Sink
+        {
+        public:
+            /*** Constructors ***/
+
+            /* Constructor which takes in the callback, called with a view that is only valid during the call */
+            explicit CallbackSink(std::function<void(ByteView)>);
+
+
+            /*** Public Methods ***/
+
+            using Sink::write;
+
+            void                write(const ByteView) override;
+
+
+        private:
+            /*** Private Member Variables ***/
+
+            std::function<void(ByteView)> m_callback;
+        };
+
+        /* Sink writing synchronously to an existing std::ostream, which must outlive it */
+        class StreamSink : public Sink
+        {
+        public:
+            /*** Constructors ***/
+
+            /* Constructor which takes in the stream */
+            explicit StreamSink(std::ostream&);
+
+
+            /*** Public Methods ***/
+
+            using Sink::write;
+
+            void                write(const ByteView) override;
+
+            void                flush() override;
+
+
+        private:
+            /*** Private Member Variables ***/
+
+            std::ostream& m_stream;
+        };
+    }
+}
+
+#endif /* TYPES_SINK */
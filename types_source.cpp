@@ -0,0 +1,173 @@
+/*
+ * @brief kim::sec::FileSource Source File
+ * @author Edward Kim
+ */
+#include "types_source.hpp"
+
+#include <stdexcept>
+#include <iterator>
+#include <algorithm>
+#include <cstring>
+
+#include <sys/stat.h>
+
+namespace kim
+{
+    namespace sec
+    {
+        FileSource::FileSource(const std::string& p_file_name) : m_file_name{p_file_name}
+        {
+            struct stat file_stat{};
+
+            if (::stat(p_file_name.c_str(), &file_stat) == 0 && S_ISREG(file_stat.st_mode)) {
+                m_map.emplace(p_file_name);
+                return;
+            }
+
+            m_own = std::make_unique<std::ifstream>(p_file_name, std::ios::binary);
+
+            if (!*m_own) {
+                throw std::runtime_error(std::string("Cannot open ") + p_file_name);
+            }
+
+            m_stream = m_own.get();
+            m_start = m_stream->tellg();
+        }
+
+        FileSource::FileSource(std::istream& p_stream) : m_stream{&p_stream}, m_start{p_stream.tellg()}
+        {
+            /* tellg() fails on pipes, which must not leave the stream unusable */
+            m_stream->clear(m_stream->rdstate() & ~std::ios::failbit);
+        }
+
+        FileSource::FileSource(FileSource&&) noexcept = default;
+
+        FileSource::~FileSource() { }
+
+        bool FileSource::mapped() const
+        {
+            return m_map.has_value();
+        }
+
+        const std::string& FileSource::file_name() const
+        {
+            return m_file_name;
+        }
+
+        bool FileSource::next_line(std::string_view& p_line)
+        {
+            if (m_map) {
+                const std::string_view contents{m_map->str()};
+
+                if (m_pos >= contents.length()) {
+                    return false;
+                }
+
+                const void*         line_end{std::memchr(contents.data() + m_pos, '\n', contents.length() - m_pos)};
+                const std::size_t   end{line_end ? static_cast<std::size_t>(static_cast<const char*>(line_end) - contents.data())
+                                                 : contents.length()};
+
+                p_line = contents.substr(m_pos, end - m_pos);
+                m_pos = end + 1;
+
+                if (!p_line.empty() && p_line.back() == '\r') {
+                    p_line.remove_suffix(1);
+                }
+
+                return true;
+            }
+
+            if (!std::getline(*m_stream, m_buffer)) {
+                return false;
+            }
+
+            /* The LF was consumed unless the last line ran into the end of the stream */
+            m_offset += m_buffer.length() + (m_stream->eof() ? 0 : 1);
+            p_line = m_buffer;
+
+            if (!p_line.empty() && p_line.back() == '\r') {
+                p_line.remove_suffix(1);
+            }
+
+            return true;
+        }
+
+        std::string_view FileSource::rest()
+        {
+            if (m_map) {
+                const std::string_view contents{m_map->str()};
+                const std::size_t      pos{std::min(m_pos, contents.length())};
+
+                m_pos = contents.length();
+
+                return contents.substr(pos);
+            }
+
+            m_buffer.assign(std::istreambuf_iterator<char>{*m_stream}, std::istreambuf_iterator<char>{});
+            m_offset += m_buffer.length();
+
+            return m_buffer;
+        }
+
+        std::string_view FileSource::joined_lines()
+        {
+            std::string_view all{rest()};
+
+            /* Drop a trailing LF, as std::getline would not return an empty last line, and the CR of a CR LF */
+            if (!all.empty() && all.back() == '\n') {
+                all.remove_suffix(1);
+            }
+
+            if (!all.empty() && all.back() == '\r') {
+                all.remove_suffix(1);
+            }
+
+            if (all.find('\n') == std::string_view::npos) {
+                return all;
+            }
+
+            std::string joined{};
+
+            joined.reserve(all.length());
+
+            for (std::size_t pos{}; pos <= all.length();) {
+                const std::size_t end{std::min(all.find('\n', pos), all.length())};
+
+                joined.append(all.data() + pos, end - pos - (end > pos && all[end - 1] == '\r' ? 1 : 0));
+                pos = end + 1;
+            }
+
+            m_buffer = std::move(joined);
+
+            return m_buffer;
+        }
+
+        std::size_t FileSource::offset() const
+        {
+            return m_map ? std::min(m_pos, m_map->length()) : m_offset;
+        }
+
+        void FileSource::seek(const std::size_t p_offset)
+        {
+            if (m_map) {
+                m_pos = std::min(p_offset, m_map->length());
+                return;
+            }
+
+            m_stream->clear();
+
+            if (m_start >= 0 && m_stream->seekg(m_start + static_cast<std::streamoff>(p_offset))) {
+                m_offset = p_offset;
+                return;
+            }
+
+            if (p_offset < m_offset) {
+                throw std::runtime_error("Cannot seek backwards in a stream");
+            }
+
+            m_stream->clear();
+            m_stream->ignore(static_cast<std::streamsize>(p_offset - m_offset));
+            m_offset += static_cast<std::size_t>(m_stream->gcount());
+        }
+    }
+}
@@ -0,0 +1,126 @@
+/*
+ * @brief kim::sec::FileSource Header File
+ * @author Edward Kim
+ */
+#ifndef TYPES_SOURCE
+#define TYPES_SOURCE
+
+#include <istream>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <cstddef>
+
+#include "types_view.hpp"
+#include "types_mmap.hpp"
+
+/* FileSource Class Declaration */
+namespace kim
+{
+    namespace sec
+    {
+        /*
+         * Input for the file-based attacks, read without going through iostreams where possible
+         * - Regular files are memory mapped and handed out as views into the mapping, without copying
+         * - Pipes, terminals and existing streams fall back to reading through std::istream
+         * - Views handed out stay valid until the next call (streams) or for the life of the FileSource (mapped files)
+         */
+        class FileSource
+        {
+        public:
+            /*** Constructors/Destructor ***/
+
+            /* Constructor which takes in the file name (throws std::runtime_error if it cannot be opened) */
+            explicit FileSource(const std::string&);
+
+            /* Constructor which takes in an open stream, read from its current position (the stream must outlive the FileSource) */
+            explicit FileSource(std::istream&);
+
+            FileSource(const FileSource&) = delete;
+            FileSource& operator=(const FileSource&) = delete;
+
+            /* Move Constructor */
+            FileSource(FileSource&&) noexcept;
+
+            /* Destructor */
+            ~FileSource();
+
+
+            /*** Public Methods ***/
+
+            /* Returns true if the input is memory mapped, else false */
+            bool                mapped() const;
+
+            /* Returns the file name, or an empty string if it was constructed from a stream */
+            const std::string&  file_name() const;
+
+            /* Reads the next line without its LF or CR LF, like std::getline
+             * - Returns false once the input is exhausted
+             */
+            bool                next_line(std::string_view&);
+
+            /* Returns the rest of the input */
+            std::string_view    rest();
+
+            /* Returns the rest of the lines joined together without their LFs or CR LFs (copies only if there are several lines) */
+            std::string_view    joined_lines();
+
+            /* Returns the number of bytes read since the start of the input (or the stream position it was constructed at) */
+            std::size_t         offset() const;
+
+            /* Moves to an offset from the start of the input, as returned by offset()
+             * - Mapped files and seekable streams jump there directly
+             * - Other streams skip forwards by reading (throws std::runtime_error when asked to go backwards)
+             */
+            void                seek(const std::size_t);
+
+
+        private:
+            /*** Private Member Variables ***/
+
+            /* File name, empty for a stream */
+            std::string m_file_name{};
+
+            /* Mapping of a regular file */
+            std::optional<MappedFile> m_map{};
+
+            /* Read position in the mapping */
+            std::size_t m_pos{};
+
+            /* Stream opened by the FileSource itself */
+            std::unique_ptr<std::ifstream> m_own{};
+
+            /* Stream read from when the input is not mapped */
+            std::istream* m_stream{};
+
+            /* Stream position at construction, or -1 if the stream cannot seek */
+            std::streamoff m_start{-1};
+
+            /* Bytes read from the stream */
+            std::size_t m_offset{};
+
+            /* Buffer for stream reads and joined lines */
+            std::string m_buffer{};
+        };
+
+        namespace detail
+        {
+            /* Constructs a kim::sec security type from text, without an intermediate std::string where the type allows it */
+            template <class Container>
+            Container from_text(const std::string_view p_text)
+            {
+                if constexpr (std::is_constructible_v<Container, std::string_view>) {
+                    return Container{p_text};
+                } else {
+                    return Container{std::string{p_text}};
+                }
+            }
+        }
+    }
+}
+
+#endif /* TYPES_SOURCE */
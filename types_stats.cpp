@@ -0,0 +1,219 @@
+/*
+ * @brief kim::sec::Stats Source File
+ * @author Edward Kim
+ */
+#include "types_stats.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace kim
+{
+    namespace sec
+    {
+        static constexpr std::size_t probe_count{static_cast<std::size_t>(probe::count)};
+
+        /* One set of counters, written only by its owning thread and read by snapshots */
+        struct probe_counters
+        {
+            std::array<std::atomic<std::uint64_t>, probe_count> calls{};
+            std::array<std::atomic<std::uint64_t>, probe_count> bytes{};
+            std::array<std::atomic<std::uint64_t>, probe_count> bin_allocs{};
+            std::array<std::atomic<std::uint64_t>, probe_count> cycles{};
+        };
+
+        /* Registry of live threads' counters plus the totals of exited threads */
+        struct stats_registry
+        {
+            std::mutex                      mutex;
+            std::vector<probe_counters*>    live;
+            probe_counters                  retired;
+        };
+
+        static stats_registry& registry()
+        {
+            static stats_registry ret{};
+
+            return ret;
+        }
+
+        /* Per-thread counters, registered on first use and folded into the retired totals on thread exit */
+        struct thread_counters
+        {
+            probe_counters  counters{};
+            probe           active{probe::count};
+
+            thread_counters()
+            {
+                const std::lock_guard<std::mutex> lock{registry().mutex};
+                registry().live.push_back(&counters);
+            }
+
+            ~thread_counters()
+            {
+                stats_registry&                     reg{registry()};
+                const std::lock_guard<std::mutex>   lock{reg.mutex};
+
+                for (std::size_t index{}; index < probe_count; index++) {
+                    reg.retired.calls[index] += counters.calls[index].load(std::memory_order_relaxed);
+                    reg.retired.bytes[index] += counters.bytes[index].load(std::memory_order_relaxed);
+                    reg.retired.bin_allocs[index] += counters.bin_allocs[index].load(std::memory_order_relaxed);
+                    reg.retired.cycles[index] += counters.cycles[index].load(std::memory_order_relaxed);
+                }
+
+                reg.live.erase(std::remove(reg.live.begin(), reg.live.end(), &counters), reg.live.end());
+            }
+        };
+
+        /* Counters have a single writer, so a relaxed load and store is enough and avoids a locked read-modify-write */
+        static void bump(std::atomic<std::uint64_t>& p_counter, const std::uint64_t p_value)
+        {
+            p_counter.store(p_counter.load(std::memory_order_relaxed) + p_value, std::memory_order_relaxed);
+        }
+
+        static thread_counters& local_counters()
+        {
+            thread_local thread_counters ret{};
+
+            return ret;
+        }
+
+        void Stats::record(const probe p_probe, const std::uint64_t p_bytes, const std::uint64_t p_cycles)
+        {
+            probe_counters&     counters{local_counters().counters};
+            const std::size_t   index{static_cast<std::size_t>(p_probe)};
+
+            bump(counters.calls[index], 1);
+            bump(counters.bytes[index], p_bytes);
+            bump(counters.cycles[index], p_cycles);
+        }
+
+        void Stats::record_bin_alloc()
+        {
+            thread_counters& local{local_counters()};
+
+            if (local.active != probe::count) {
+                bump(local.counters.bin_allocs[static_cast<std::size_t>(local.active)], 1);
+            }
+        }
+
+        std::array<probe_snapshot, static_cast<std::size_t>(probe::count)> Stats::snapshot()
+        {
+            static constexpr const char* names[probe_count] = { "XOR_byte_dec", "XOR_rep_key_dec", "aes_ecb_dec",
+                                                                "Hex_parse", "Hex_to_Bin", "Hex_to_B64",
+                                                                "Base64_parse", "Base64_to_Bin", "Base64_to_Hex",
+                                                                "Binary_to_Hex", "Binary_to_B64" };
+
+            std::array<probe_snapshot, probe_count>     ret{};
+            stats_registry&                             reg{registry()};
+            const std::lock_guard<std::mutex>           lock{reg.mutex};
+
+            auto add{
+                        [&ret](const probe_counters& p_counters)
+                        {
+                            for (std::size_t index{}; index < probe_count; index++) {
+                                ret[index].calls += p_counters.calls[index].load(std::memory_order_relaxed);
+                                ret[index].bytes += p_counters.bytes[index].load(std::memory_order_relaxed);
+                                ret[index].bin_allocs += p_counters.bin_allocs[index].load(std::memory_order_relaxed);
+                                ret[index].cycles += p_counters.cycles[index].load(std::memory_order_relaxed);
+                            }
+                        }
+                    };
+
+            for (std::size_t index{}; index < probe_count; index++) {
+                ret[index].name = names[index];
+            }
+
+            add(reg.retired);
+
+            for (const probe_counters* e : reg.live) {
+                add(*e);
+            }
+
+            return ret;
+        }
+
+        void Stats::dump(std::ostream& os)
+        {
+            const auto snap{snapshot()};
+
+            os << "{ \"probes\": [";
+
+            for (std::size_t index{}; index < snap.size(); index++) {
+                os << (index ? ",\n  " : "\n  ")
+                   << "{ \"name\": \"" << snap[index].name << "\""
+                   << ", \"calls\": " << snap[index].calls
+                   << ", \"bytes\": " << snap[index].bytes
+                   << ", \"binary_allocs\": " << snap[index].bin_allocs
+                   << ", \"cycles\": " << snap[index].cycles << " }";
+            }
+
+            os << "\n] }" << std::endl;
+        }
+
+        void Stats::reset()
+        {
+            stats_registry&                     reg{registry()};
+            const std::lock_guard<std::mutex>   lock{reg.mutex};
+
+            auto zero{
+                        [](probe_counters& p_counters)
+                        {
+                            for (std::size_t index{}; index < probe_count; index++) {
+                                p_counters.calls[index].store(0, std::memory_order_relaxed);
+                                p_counters.bytes[index].store(0, std::memory_order_relaxed);
+                                p_counters.bin_allocs[index].store(0, std::memory_order_relaxed);
+                                p_counters.cycles[index].store(0, std::memory_order_relaxed);
+                            }
+                        }
+                    };
+
+            zero(reg.retired);
+
+            for (probe_counters* e : reg.live) {
+                zero(*e);
+            }
+        }
+
+        std::uint64_t Stats::cycles()
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+#else
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+        }
+
+        probe Stats::enter(const probe p_probe)
+        {
+            thread_counters&    local{local_counters()};
+            const probe         ret{local.active};
+
+            local.active = p_probe;
+
+            return ret;
+        }
+
+        void Stats::leave(const probe p_probe)
+        {
+            local_counters().active = p_probe;
+        }
+
+        ScopedProbe::ScopedProbe(const probe p_probe, const std::uint64_t p_bytes)
+            : m_probe{p_probe}, m_outer{Stats::enter(p_probe)}, m_bytes{p_bytes}, m_start{Stats::cycles()} { }
+
+        ScopedProbe::~ScopedProbe()
+        {
+            Stats::record(m_probe, m_bytes, Stats::cycles() - m_start);
+            Stats::leave(m_outer);
+        }
+    }
+}
@@ -0,0 +1,121 @@
+/*
+ * @brief kim::sec::Stats Header File
+ * @author Edward Kim
+ *
+ * Hot-path instrumentation, compiled in only when KIM_SEC_STATS is defined (make STATS=1).
+ * Without it the KIM_SEC_PROBE and KIM_SEC_COUNT_BIN_ALLOC macros expand to nothing.
+ * KIM_SEC_STATS must be defined the same way for every translation unit of a program.
+ */
+#ifndef TYPES_STATS
+#define TYPES_STATS
+
+#include <iostream>
+#include <array>
+
+#include <cstdint>
+#include <cstddef>
+
+/* Stats Class Declaration */
+namespace kim
+{
+    namespace sec
+    {
+        /* Instrumented primitives */
+        enum class probe : std::size_t
+        {
+            XOR_byte_dec,
+            XOR_rep_key_dec,
+            aes_ecb_dec,
+            Hex_parse,
+            Hex_to_Bin,
+            Hex_to_B64,
+            Base64_parse,
+            Base64_to_Bin,
+            Base64_to_Hex,
+            Binary_to_Hex,
+            Binary_to_B64,
+            count
+        };
+
+        /* Totals for one primitive, summed over all threads
+         * - Cycles are inclusive of any instrumented primitive called from within
+         * - Binary allocations are Binary heap buffers allocated while the primitive was the innermost active probe,
+         *   the strings of kim::sec::Hex and kim::sec::Base64 are not counted
+         */
+        struct probe_snapshot
+        {
+            const char*     name;
+            std::uint64_t   calls;
+            std::uint64_t   bytes;
+            std::uint64_t   bin_allocs;
+            std::uint64_t   cycles;
+        };
+
+        class Stats
+        {
+        public:
+            /*** Static Methods ***/
+
+            /* Adds one call of a primitive on the calling thread's counters */
+            static void         record(const probe, const std::uint64_t p_bytes, const std::uint64_t p_cycles);
+
+            /* Adds one Binary heap buffer allocation to the calling thread's innermost active probe */
+            static void         record_bin_alloc();
+
+            /* Returns the totals of every primitive over all threads, live and exited */
+            static std::array<probe_snapshot, static_cast<std::size_t>(probe::count)> snapshot();
+
+            /* Writes the snapshot as JSON */
+            static void         dump(std::ostream&);
+
+            /* Zeroes every counter (a call being recorded on another thread at the same time may keep its old total) */
+            static void         reset();
+
+            /* Returns a timestamp in cycles (TSC on x86, nanoseconds elsewhere) */
+            static std::uint64_t cycles();
+
+            /* Makes a primitive the calling thread's innermost active probe, returning the previous one */
+            static probe        enter(const probe);
+
+            /* Restores the previous innermost active probe */
+            static void         leave(const probe);
+        };
+
+        /* Records a call of a primitive from construction to destruction */
+        class ScopedProbe
+        {
+        public:
+            /*** Constructors/Destructor ***/
+
+            /* Constructor which takes in the primitive and the number of bytes it processes */
+            ScopedProbe(const probe, const std::uint64_t);
+
+            ScopedProbe(const ScopedProbe&) = delete;
+            ScopedProbe& operator=(const ScopedProbe&) = delete;
+
+            /* Destructor */
+            ~ScopedProbe();
+
+
+        private:
+            /*** Private Member Variables ***/
+
+            probe           m_probe;
+            probe           m_outer;
+            std::uint64_t   m_bytes;
+            std::uint64_t   m_start;
+        };
+    }
+}
+
+#if defined(KIM_SEC_STATS)
+#define KIM_SEC_PROBE_CONCAT_(p_lhs, p_rhs) p_lhs##p_rhs
+#define KIM_SEC_PROBE_NAME_(p_line) KIM_SEC_PROBE_CONCAT_(kim_sec_probe_, p_line)
+#define KIM_SEC_PROBE(p_probe, p_bytes) const ::kim::sec::ScopedProbe KIM_SEC_PROBE_NAME_(__LINE__){p_probe, p_bytes}
+#define KIM_SEC_COUNT_BIN_ALLOC() ::kim::sec::Stats::record_bin_alloc()
+#else
+#define KIM_SEC_PROBE(p_probe, p_bytes) static_cast<void>(0)
+#define KIM_SEC_COUNT_BIN_ALLOC() static_cast<void>(0)
+#endif
+
+#endif /* TYPES_STATS */
@@ -0,0 +1,213 @@
+/*
+ * @brief kim::sec Validation Routines Source File
+ * @author Edward Kim
+ */
+#include "types_validate.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace kim
+{
+    namespace sec
+    {
+        namespace detail
+        {
+#if defined(__SSE2__)
+            /* Per-byte mask of the characters in [p_lo, p_hi] (signed compares are fine as every range is ASCII) */
+            static inline __m128i in_range(const __m128i p_chrs, const char p_lo, const char p_hi)
+            {
+                return _mm_and_si128(_mm_cmpgt_epi8(p_chrs, _mm_set1_epi8(static_cast<char>(p_lo - 1))),
+                                     _mm_cmplt_epi8(p_chrs, _mm_set1_epi8(static_cast<char>(p_hi + 1))));
+            }
+
+            /* Reverses the order of the bytes within each 64-bit half */
+            static inline __m128i reverse_octets(const __m128i p_chrs)
+            {
+                const __m128i words{_mm_shufflehi_epi16(_mm_shufflelo_epi16(p_chrs, 0x1B), 0x1B)};
+
+                return _mm_or_si128(_mm_slli_epi16(words, 8), _mm_srli_epi16(words, 8));
+            }
+#endif
+
+            std::size_t hex_copy_upper(const char* p_src, const std::size_t p_len, char* p_dst)
+            {
+                std::size_t index{};
+
+#if defined(__SSE2__)
+                for (; index + 16 <= p_len; index += 16) {
+                    const __m128i   chrs{_mm_loadu_si128(reinterpret_cast<const __m128i*>(p_src + index))};
+                    const __m128i   lower{in_range(chrs, 'a', 'f')};
+                    const __m128i   valid{_mm_or_si128(_mm_or_si128(in_range(chrs, '0', '9'), in_range(chrs, 'A', 'F')), lower)};
+                    const int       mask{_mm_movemask_epi8(valid)};
+
+                    /* The scalar loop copies the valid characters before the bad one and returns its offset */
+                    if (mask != 0xFFFF) {
+                        break;
+                    }
+
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(p_dst + index),
+                                     _mm_sub_epi8(chrs, _mm_and_si128(lower, _mm_set1_epi8(0x20))));
+                }
+#endif
+
+                for (; index < p_len; index++) {
+                    const char curr{p_src[index]};
+
+                    if (curr >= '0' && curr <= '9') {
+                        p_dst[index] = curr;
+                    } else if (curr >= 'A' && curr <= 'F') {
+                        p_dst[index] = curr;
+                    } else if (curr >= 'a' && curr <= 'f') {
+                        p_dst[index] = static_cast<char>(curr - 0x20);
+                    } else {
+                        return index;
+                    }
+                }
+
+                return p_len;
+            }
+
+            std::size_t b64_find_invalid(const char* p_src, const std::size_t p_len)
+            {
+                std::size_t index{};
+
+#if defined(__SSE2__)
+                for (; index + 16 <= p_len; index += 16) {
+                    const __m128i   chrs{_mm_loadu_si128(reinterpret_cast<const __m128i*>(p_src + index))};
+                    const __m128i   valid{_mm_or_si128(_mm_or_si128(in_range(chrs, 'A', 'Z'), in_range(chrs, 'a', 'z')),
+                                                       _mm_or_si128(in_range(chrs, '0', '9'),
+                                                                    _mm_or_si128(_mm_cmpeq_epi8(chrs, _mm_set1_epi8('+')),
+                                                                                 _mm_cmpeq_epi8(chrs, _mm_set1_epi8('/')))))};
+                    const int       mask{_mm_movemask_epi8(valid)};
+
+                    if (mask != 0xFFFF) {
+                        return index + __builtin_ctz(~mask);
+                    }
+                }
+#endif
+
+                for (; index < p_len; index++) {
+                    const char curr{p_src[index]};
+
+                    if (!((curr >= 'A' && curr <= 'Z') || (curr >= 'a' && curr <= 'z') || (curr >= '0' && curr <= '9')
+                          || curr == '+' || curr == '/')) {
+                        return index;
+                    }
+                }
+
+                return p_len;
+            }
+
+            std::size_t bits_pack(const char* p_src, const std::size_t p_len, std::byte* p_dst, std::size_t& p_bits)
+            {
+                std::size_t     index{};
+                std::size_t     out{};
+                std::uint32_t   acc{};
+                std::uint32_t   pending{};
+
+                while (index < p_len) {
+                    /* Whole bytes of bits are packed in bulk while the output is byte aligned */
+                    if (pending == 0) {
+#if defined(__SSE2__)
+                        for (; index + 32 <= p_len; index += 32, out += 4) {
+                            const __m128i lo{_mm_loadu_si128(reinterpret_cast<const __m128i*>(p_src + index))};
+                            const __m128i hi{_mm_loadu_si128(reinterpret_cast<const __m128i*>(p_src + index + 16))};
+                            const __m128i bit_mask{_mm_set1_epi8(static_cast<char>(0xFE))};
+                            const __m128i zero_chr{_mm_set1_epi8('0')};
+
+                            if ((_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(lo, bit_mask), zero_chr))
+                                 & _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(hi, bit_mask), zero_chr))) != 0xFFFF) {
+                                break;
+                            }
+
+                            /* Reversing each group of 8 characters puts the first character at the top of its mask byte */
+                            const std::uint32_t mask{static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(reverse_octets(lo), _mm_set1_epi8('1'))))
+                                                     | static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(reverse_octets(hi), _mm_set1_epi8('1')))) << 16};
+
+                            for (std::size_t k{}; k < 4; k++) {
+                                p_dst[out + k] = static_cast<std::byte>(mask >> (8 * k));
+                            }
+                        }
+#endif
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+                        for (; index + 8 <= p_len; index += 8, out++) {
+                            std::uint64_t chrs{};
+
+                            std::memcpy(&chrs, p_src + index, 8);
+
+                            if ((chrs & 0xFEFEFEFEFEFEFEFEULL) != 0x3030303030303030ULL) {
+                                break;
+                            }
+
+                            /* The multiply gathers bit 0 of character i into bit 63 - i without carries */
+                            p_dst[out] = static_cast<std::byte>(((chrs & 0x0101010101010101ULL) * 0x8040201008040201ULL) >> 56);
+                        }
+#endif
+                        if (index == p_len) {
+                            break;
+                        }
+                    }
+
+                    const char curr{p_src[index]};
+
+                    if (curr == '0' || curr == '1') {
+                        acc = (acc << 1) | static_cast<std::uint32_t>(curr - '0');
+
+                        if (++pending == 8) {
+                            p_dst[out++] = static_cast<std::byte>(acc);
+                            acc = 0;
+                            pending = 0;
+                        }
+                    } else if (curr != ' ' && curr != '\t' && curr != '\n' && curr != '\r') {
+                        p_bits = out * 8 + pending;
+                        return index;
+                    }
+
+                    index++;
+                }
+
+                p_bits = out * 8 + pending;
+
+                return p_len;
+            }
+
+            std::size_t pkcs7_pad_length(const std::byte* p_block, const std::size_t p_block_size)
+            {
+                const std::uint32_t pad{std::to_integer<std::uint32_t>(p_block[p_block_size - 1])};
+                const std::uint32_t size{static_cast<std::uint32_t>(p_block_size)};
+                std::uint32_t       diff{};
+
+#if defined(__SSE2__)
+                if (p_block_size == 16) {
+                    /* Byte j must equal the pad if it is one of the last pad bytes, i.e. 15 - j < pad */
+                    const __m128i   block{_mm_loadu_si128(reinterpret_cast<const __m128i*>(p_block))};
+                    const __m128i   pad_vec{_mm_set1_epi8(static_cast<char>(pad))};
+                    const __m128i   from_end{_mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)};
+                    const __m128i   inside{_mm_cmplt_epi8(from_end, _mm_min_epu8(pad_vec, _mm_set1_epi8(16)))};
+
+                    diff = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_andnot_si128(_mm_cmpeq_epi8(block, pad_vec), inside)));
+                } else
+#endif
+                {
+                    for (std::uint32_t from_end{}; from_end < size; from_end++) {
+                        /* All ones if the byte is one of the last pad bytes, without branching */
+                        const std::uint32_t inside{0U - ((from_end - pad) >> 31)};
+
+                        diff |= (std::to_integer<std::uint32_t>(p_block[size - 1 - from_end]) ^ pad) & inside;
+                    }
+                }
+
+                /* 1 if 1 <= pad <= block size, and 1 if every inside byte matched */
+                const std::uint32_t in_range{1U ^ (((pad - 1U) | (size - pad)) >> 31)};
+                const std::uint32_t matched{(diff - 1U) >> 31};
+
+                return pad & (0U - (in_range & matched));
+            }
+        }
+    }
+}
@@ -0,0 +1,48 @@
+/*
+ * @brief kim::sec Validation Routines Header File
+ * @author Edward Kim
+ */
+#ifndef TYPES_VALIDATE
+#define TYPES_VALIDATE
+
+#include <cstddef>
+
+/* Validation Routines used by the Binary, Hexadecimal and Base64 constructors and PKCS#7 unpadding */
+namespace kim
+{
+    namespace sec
+    {
+        namespace detail
+        {
+            /* Copies Hexadecimal characters in uppercase
+             * - First argument is the source, second argument is the number of characters
+             * - Third argument is the destination (may be the same as the source)
+             * - Returns the offset of the first character that is not from 0-9, A-F or a-f,
+             *   or the number of characters if they are all valid
+             */
+            std::size_t     hex_copy_upper(const char*, const std::size_t, char*);
+
+            /* Returns the offset of the first character that is not from A-Z, a-z, 0-9, + or /,
+             * or the number of characters if they are all valid
+             */
+            std::size_t     b64_find_invalid(const char*, const std::size_t);
+
+            /* Packs a string of 0s and 1s into bytes, most significant bit first, skipping spaces, tabs and newlines
+             * - First argument is the source, second argument is the number of characters
+             * - Third argument is the destination, with room for one byte per 8 characters
+             * - Fourth argument receives the number of bits read (only whole bytes are written)
+             * - Returns the offset of the first character that is neither a bit nor whitespace,
+             *   or the number of characters if they are all valid
+             */
+            std::size_t     bits_pack(const char*, const std::size_t, std::byte*, std::size_t&);
+
+            /* Returns the PKCS#7 padding length of the final block, or 0 if the padding is invalid
+             * - First argument is the final block, second argument is the block size (1-255)
+             * - Runs in constant time: every byte of the block is inspected whatever its contents
+             */
+            std::size_t     pkcs7_pad_length(const std::byte*, const std::size_t);
+        }
+    }
+}
+
+#endif /* TYPES_VALIDATE */
@@ -0,0 +1,202 @@
+/*
+ * @brief kim::sec::ByteView Header File
+ * @author Edward Kim
+ */
+#ifndef TYPES_VIEW
+#define TYPES_VIEW
+
+#include <stdexcept>
+
+#include <cstddef>
+
+#include "types_validate.hpp"
+
+/* ByteView and BatchView Class Declarations */
+namespace kim
+{
+    namespace sec
+    {
+        /*
+         * Non-owning, read-only view over a contiguous run of bytes (pointer and length)
+         * - Cheap to copy and pass by value
+         * - The viewed buffer must outlive the view
+         */
+        class ByteView
+        {
+        public:
+            /*** Constructors ***/
+
+            /* Empty Constructor */
+            constexpr ByteView() noexcept = default;
+
+            /* Constructor which takes in a pointer to the first byte and a length */
+            constexpr ByteView(const std::byte* p_data, const std::size_t p_len) noexcept
+                : m_data{p_data}, m_len{p_len} { }
+
+
+            /*** Public Methods ***/
+
+            /* Returns the number of bytes in the view */
+            constexpr std::size_t       length() const noexcept { return m_len; }
+
+            /* Returns true if the view is empty, else false */
+            constexpr bool              empty() const noexcept { return m_len == 0; }
+
+            /* Returns a pointer to the first byte */
+            constexpr const std::byte*  data() const noexcept { return m_data; }
+
+            /* Iterators */
+            constexpr const std::byte*  begin() const noexcept { return m_data; }
+            constexpr const std::byte*  end() const noexcept { return m_data + m_len; }
+
+            /* Returns a part of the view without copying
+             * - First argument is the index
+             * - Second argument is the length (clamped to the end of the view)
+             */
+            constexpr ByteView          subview(const std::size_t p_index, std::size_t p_len) const
+            {
+                if (p_index > m_len) {
+                    throw std::out_of_range("Index of sub ByteView is out of range");
+                }
+
+                if (p_len > m_len - p_index) {
+                    p_len = m_len - p_index;
+                }
+
+                return ByteView{m_data + p_index, p_len};
+            }
+
+            /* Returns the view without its PKCS#7 padding, without copying
+             * - Argument is the block size (1-255)
+             * - The padding is validated in constant time, throwing std::invalid_argument if it is invalid
+             */
+            ByteView                    pkcs7_unpad(const std::size_t p_block_size = 16) const
+            {
+                if (p_block_size == 0 || p_block_size > 255) {
+                    throw std::invalid_argument("PKCS#7 block size is not from 1 to 255");
+                }
+
+                if (m_len == 0 || m_len % p_block_size != 0) {
+                    throw std::invalid_argument("PKCS#7 padded data is not a non-zero multiple of the block size");
+                }
+
+                const std::size_t pad{detail::pkcs7_pad_length(m_data + m_len - p_block_size, p_block_size)};
+
+                if (pad == 0) {
+                    throw std::invalid_argument("Invalid PKCS#7 padding");
+                }
+
+                return ByteView{m_data, m_len - pad};
+            }
+
+
+            /*** Public Member Operators ***/
+
+            /* Constant subscript operator */
+            constexpr std::byte         operator[](const std::size_t p_index) const noexcept { return m_data[p_index]; }
+
+
+        private:
+            /*** Private Member Variables ***/
+
+            /* First byte of the viewed buffer */
+            const std::byte* m_data{};
+
+            /* Number of bytes in the viewed buffer */
+            std::size_t m_len{};
+        };
+
+        /*
+         * Non-owning, read-only view over a batch of records stored back to back in one buffer
+         * - Structure-of-arrays layout: one byte buffer plus either a fixed record size or an offsets array
+         * - With offsets, record i is [offsets[i], offsets[i + 1]) so the array holds one more entry than there are records
+         * - The viewed buffer and offsets must outlive the view
+         */
+        class BatchView
+        {
+        public:
+            /*** Constructors ***/
+
+            /* Empty Constructor */
+            constexpr BatchView() noexcept = default;
+
+            /* Constructor which takes in the buffer and the size of every record (the buffer length must be a multiple of it) */
+            constexpr BatchView(const ByteView p_data, const std::size_t p_stride)
+                : m_data{p_data}, m_stride{p_stride}, m_count{p_stride ? p_data.length() / p_stride : 0}
+            {
+                if (p_stride == 0 || p_data.length() % p_stride != 0) {
+                    throw std::invalid_argument("BatchView buffer is not a multiple of the record size");
+                }
+            }
+
+            /* Constructor which takes in the buffer, the record offsets and the number of records */
+            constexpr BatchView(const ByteView p_data, const std::size_t* p_offsets, const std::size_t p_count)
+                : m_data{p_data}, m_offsets{p_offsets}, m_count{p_count}
+            {
+                for (std::size_t index{}; index < p_count; index++) {
+                    if (p_offsets[index] > p_offsets[index + 1]) {
+                        throw std::invalid_argument("BatchView offsets are not in order");
+                    }
+                }
+
+                if (p_count && p_offsets[p_count] > p_data.length()) {
+                    throw std::invalid_argument("BatchView offsets are out of range");
+                }
+            }
+
+
+            /*** Public Methods ***/
+
+            /* Returns the number of records */
+            constexpr std::size_t       size() const noexcept { return m_count; }
+
+            /* Returns true if there are no records, else false */
+            constexpr bool              empty() const noexcept { return m_count == 0; }
+
+            /* Returns the offset of a record in the buffer (the total length for size()) */
+            constexpr std::size_t       offset(const std::size_t p_index) const noexcept
+            {
+                return m_offsets ? m_offsets[p_index] : p_index * m_stride;
+            }
+
+            /* Returns the length of a record */
+            constexpr std::size_t       length(const std::size_t p_index) const noexcept
+            {
+                return m_offsets ? m_offsets[p_index + 1] - m_offsets[p_index] : m_stride;
+            }
+
+            /* Returns the bytes of all records, back to back */
+            constexpr ByteView          records() const noexcept
+            {
+                return m_count ? ByteView{m_data.data() + offset(0), offset(m_count) - offset(0)} : ByteView{};
+            }
+
+
+            /*** Public Member Operators ***/
+
+            /* Returns a view of a record */
+            constexpr ByteView          operator[](const std::size_t p_index) const noexcept
+            {
+                return ByteView{m_data.data() + offset(p_index), length(p_index)};
+            }
+
+
+        private:
+            /*** Private Member Variables ***/
+
+            /* Buffer holding the records */
+            ByteView m_data{};
+
+            /* Offsets of the records, or nullptr for fixed size records */
+            const std::size_t* m_offsets{};
+
+            /* Size of every record when there are no offsets */
+            std::size_t m_stride{};
+
+            /* Number of records */
+            std::size_t m_count{};
+        };
+    }
+}
+
+#endif /* TYPES_VIEW */